@@ -59,8 +59,279 @@ int aero_rep_get_used_jac_elem(ModelData *model_data, int aero_rep_idx,
       break;
   }
 
+  // Record the phase instance as used for the cached aerosol properties
+  if (model_data->aero_phase_inst_num_jac_elem != NULL) {
+    model_data->aero_phase_inst_num_jac_elem
+        [model_data->aero_rep_phase_inst_idx[aero_rep_idx] + aero_phase_idx] =
+        num_flagged_elem;
+  }
+
   return num_flagged_elem;
 }
+
+/** \brief Set up the aerosol phase instance indices for the property cache
+ *
+ * Counts the aerosol phase instances in each aerosol representation. Must be
+ * called before the reactions flag their Jacobian elements, so that calls to
+ * \c aero_rep_get_used_jac_elem() can record the phase instances used by the
+ * mechanism.
+ *
+ * \param model_data Pointer to the model data
+ */
+void aero_rep_initialize_cache(ModelData *model_data) {
+  int n_aero_rep = model_data->n_aero_rep;
+
+  model_data->aero_rep_phase_inst_idx =
+      (int *)malloc((n_aero_rep + 1) * sizeof(int));
+  if (model_data->aero_rep_phase_inst_idx == NULL) {
+    printf(
+        "\n\nERROR allocating space for aerosol phase instance indices\n\n");
+    exit(EXIT_FAILURE);
+  }
+
+  // Get the number of phase instances in each aerosol representation
+  model_data->aero_rep_phase_inst_idx[0] = 0;
+  for (int i_aero_rep = 0; i_aero_rep < n_aero_rep; i_aero_rep++) {
+    // Get pointers to the aerosol data
+    int *aero_rep_int_data = &(
+        model_data
+            ->aero_rep_int_data[model_data->aero_rep_int_indices[i_aero_rep]]);
+    double *aero_rep_float_data =
+        &(model_data->aero_rep_float_data
+              [model_data->aero_rep_float_indices[i_aero_rep]]);
+
+    // Get the aerosol representation type
+    int aero_rep_type = *(aero_rep_int_data++);
+
+    int n_inst = 0;
+    switch (aero_rep_type) {
+      case AERO_REP_MODAL_BINNED_MASS:
+        n_inst = aero_rep_modal_binned_mass_get_num_phase_instances(
+            aero_rep_int_data, aero_rep_float_data);
+        break;
+      case AERO_REP_SINGLE_PARTICLE:
+        n_inst = aero_rep_single_particle_get_num_phase_instances(
+            aero_rep_int_data, aero_rep_float_data);
+        break;
+    }
+    model_data->aero_rep_phase_inst_idx[i_aero_rep + 1] =
+        model_data->aero_rep_phase_inst_idx[i_aero_rep] + n_inst;
+  }
+  model_data->n_aero_phase_inst =
+      model_data->aero_rep_phase_inst_idx[n_aero_rep];
+
+  // Flag all phase instances as unused until a reaction requests them
+  model_data->aero_phase_inst_num_jac_elem =
+      (int *)malloc((model_data->n_aero_phase_inst + 1) * sizeof(int));
+  if (model_data->aero_phase_inst_num_jac_elem == NULL) {
+    printf(
+        "\n\nERROR allocating space for aerosol phase instance Jacobian "
+        "element counts\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i_inst = 0; i_inst < model_data->n_aero_phase_inst; i_inst++)
+    model_data->aero_phase_inst_num_jac_elem[i_inst] = -1;
+}
+
+/** \brief Allocate the cached aerosol phase instance property arrays
+ *
+ * Must be called after the reactions have flagged their Jacobian elements.
+ * Space is only set aside for partial derivatives of the phase instances
+ * used by the mechanism.
+ *
+ * \param model_data Pointer to the model data
+ */
+void aero_rep_build_cache(ModelData *model_data) {
+  int n_inst = model_data->n_aero_phase_inst;
+
+  model_data->aero_phase_inst_jac_idx =
+      (int *)malloc((n_inst + 1) * sizeof(int));
+  model_data->aero_phase_inst_conc_type =
+      (int *)malloc((n_inst + 1) * sizeof(int));
+  if (model_data->aero_phase_inst_jac_idx == NULL ||
+      model_data->aero_phase_inst_conc_type == NULL) {
+    printf(
+        "\n\nERROR allocating space for aerosol phase instance data\n\n");
+    exit(EXIT_FAILURE);
+  }
+
+  // Set the partial derivative offsets and concentration types
+  int n_jac_elem = 0;
+  for (int i_aero_rep = 0; i_aero_rep < model_data->n_aero_rep; i_aero_rep++) {
+    // Get pointers to the aerosol data
+    int *aero_rep_int_data = &(
+        model_data
+            ->aero_rep_int_data[model_data->aero_rep_int_indices[i_aero_rep]]);
+    double *aero_rep_float_data =
+        &(model_data->aero_rep_float_data
+              [model_data->aero_rep_float_indices[i_aero_rep]]);
+
+    // Get the aerosol representation type
+    int aero_rep_type = *(aero_rep_int_data++);
+
+    int first_inst = model_data->aero_rep_phase_inst_idx[i_aero_rep];
+    int last_inst = model_data->aero_rep_phase_inst_idx[i_aero_rep + 1];
+    for (int i_inst = first_inst; i_inst < last_inst; i_inst++) {
+      int *aero_conc_type = &(model_data->aero_phase_inst_conc_type[i_inst]);
+      *aero_conc_type = 0;
+      switch (aero_rep_type) {
+        case AERO_REP_MODAL_BINNED_MASS:
+          aero_rep_modal_binned_mass_get_aero_conc_type(
+              i_inst - first_inst, aero_conc_type, aero_rep_int_data,
+              aero_rep_float_data, NULL);
+          break;
+        case AERO_REP_SINGLE_PARTICLE:
+          aero_rep_single_particle_get_aero_conc_type(
+              i_inst - first_inst, aero_conc_type, aero_rep_int_data,
+              aero_rep_float_data, NULL);
+          break;
+      }
+      model_data->aero_phase_inst_jac_idx[i_inst] = n_jac_elem;
+      if (model_data->aero_phase_inst_num_jac_elem[i_inst] > 0)
+        n_jac_elem += model_data->aero_phase_inst_num_jac_elem[i_inst];
+    }
+  }
+  model_data->aero_phase_inst_jac_idx[n_inst] = n_jac_elem;
+
+  // Allocate the property and partial derivative arrays
+  model_data->grid_cell_aero_eff_radius__m =
+      (double *)calloc(n_inst + 1, sizeof(double));
+  model_data->grid_cell_aero_number_conc__n_m3 =
+      (double *)calloc(n_inst + 1, sizeof(double));
+  model_data->grid_cell_aero_phase_mass__kg_m3 =
+      (double *)calloc(n_inst + 1, sizeof(double));
+  model_data->grid_cell_aero_phase_avg_MW__kg_mol =
+      (double *)calloc(n_inst + 1, sizeof(double));
+  model_data->grid_cell_aero_eff_radius_jac_elem =
+      (double *)calloc(n_jac_elem + 1, sizeof(double));
+  model_data->grid_cell_aero_number_conc_jac_elem =
+      (double *)calloc(n_jac_elem + 1, sizeof(double));
+  model_data->grid_cell_aero_phase_mass_jac_elem =
+      (double *)calloc(n_jac_elem + 1, sizeof(double));
+  model_data->grid_cell_aero_phase_avg_MW_jac_elem =
+      (double *)calloc(n_jac_elem + 1, sizeof(double));
+  if (model_data->grid_cell_aero_eff_radius__m == NULL ||
+      model_data->grid_cell_aero_number_conc__n_m3 == NULL ||
+      model_data->grid_cell_aero_phase_mass__kg_m3 == NULL ||
+      model_data->grid_cell_aero_phase_avg_MW__kg_mol == NULL ||
+      model_data->grid_cell_aero_eff_radius_jac_elem == NULL ||
+      model_data->grid_cell_aero_number_conc_jac_elem == NULL ||
+      model_data->grid_cell_aero_phase_mass_jac_elem == NULL ||
+      model_data->grid_cell_aero_phase_avg_MW_jac_elem == NULL) {
+    printf(
+        "\n\nERROR allocating space for cached aerosol properties\n\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/** \brief Free the cached aerosol phase instance property arrays
+ *
+ * \param model_data Pointer to the model data
+ */
+void aero_rep_free_cache(ModelData *model_data) {
+  free(model_data->aero_rep_phase_inst_idx);
+  free(model_data->aero_phase_inst_num_jac_elem);
+  free(model_data->aero_phase_inst_jac_idx);
+  free(model_data->aero_phase_inst_conc_type);
+  free(model_data->grid_cell_aero_eff_radius__m);
+  free(model_data->grid_cell_aero_number_conc__n_m3);
+  free(model_data->grid_cell_aero_phase_mass__kg_m3);
+  free(model_data->grid_cell_aero_phase_avg_MW__kg_mol);
+  free(model_data->grid_cell_aero_eff_radius_jac_elem);
+  free(model_data->grid_cell_aero_number_conc_jac_elem);
+  free(model_data->grid_cell_aero_phase_mass_jac_elem);
+  free(model_data->grid_cell_aero_phase_avg_MW_jac_elem);
+  model_data->aero_rep_phase_inst_idx = NULL;
+  model_data->aero_phase_inst_num_jac_elem = NULL;
+  model_data->aero_phase_inst_jac_idx = NULL;
+  model_data->aero_phase_inst_conc_type = NULL;
+  model_data->grid_cell_aero_eff_radius__m = NULL;
+  model_data->grid_cell_aero_number_conc__n_m3 = NULL;
+  model_data->grid_cell_aero_phase_mass__kg_m3 = NULL;
+  model_data->grid_cell_aero_phase_avg_MW__kg_mol = NULL;
+  model_data->grid_cell_aero_eff_radius_jac_elem = NULL;
+  model_data->grid_cell_aero_number_conc_jac_elem = NULL;
+  model_data->grid_cell_aero_phase_mass_jac_elem = NULL;
+  model_data->grid_cell_aero_phase_avg_MW_jac_elem = NULL;
+}
+
+/** \brief Update the cached properties of the phase instances in an aerosol
+ *         representation that are used by the mechanism
+ *
+ * \param model_data Pointer to the model data
+ * \param aero_rep_idx Index of the aerosol representation
+ * \param aero_rep_type Type of the aerosol representation
+ * \param aero_rep_int_data Pointer to the aerosol representation integer data
+ *                          (following the type)
+ * \param aero_rep_float_data Pointer to the aerosol representation
+ *                            floating-point data
+ * \param aero_rep_env_data Pointer to the aerosol representation
+ *                          environment-dependent parameters
+ * \param calc_partials Flag indicating whether to update the partial
+ *                      derivatives
+ */
+static void aero_rep_update_cache(ModelData *model_data, int aero_rep_idx,
+                                  int aero_rep_type, int *aero_rep_int_data,
+                                  double *aero_rep_float_data,
+                                  double *aero_rep_env_data,
+                                  bool calc_partials) {
+  int first_inst = model_data->aero_rep_phase_inst_idx[aero_rep_idx];
+  int last_inst = model_data->aero_rep_phase_inst_idx[aero_rep_idx + 1];
+
+  for (int i_inst = first_inst; i_inst < last_inst; i_inst++) {
+    if (model_data->aero_phase_inst_num_jac_elem[i_inst] < 0) continue;
+
+    int aero_phase_idx = i_inst - first_inst;
+    double *radius = &(model_data->grid_cell_aero_eff_radius__m[i_inst]);
+    double *number = &(model_data->grid_cell_aero_number_conc__n_m3[i_inst]);
+    double *mass = &(model_data->grid_cell_aero_phase_mass__kg_m3[i_inst]);
+    double *MW = &(model_data->grid_cell_aero_phase_avg_MW__kg_mol[i_inst]);
+    double *radius_partial = NULL;
+    double *number_partial = NULL;
+    double *mass_partial = NULL;
+    double *MW_partial = NULL;
+    if (calc_partials) {
+      int i_jac = model_data->aero_phase_inst_jac_idx[i_inst];
+      radius_partial = &(model_data->grid_cell_aero_eff_radius_jac_elem[i_jac]);
+      number_partial =
+          &(model_data->grid_cell_aero_number_conc_jac_elem[i_jac]);
+      mass_partial = &(model_data->grid_cell_aero_phase_mass_jac_elem[i_jac]);
+      MW_partial = &(model_data->grid_cell_aero_phase_avg_MW_jac_elem[i_jac]);
+    }
+
+    switch (aero_rep_type) {
+      case AERO_REP_MODAL_BINNED_MASS:
+        aero_rep_modal_binned_mass_get_effective_radius__m(
+            model_data, aero_phase_idx, radius, radius_partial,
+            aero_rep_int_data, aero_rep_float_data, aero_rep_env_data);
+        aero_rep_modal_binned_mass_get_number_conc__n_m3(
+            model_data, aero_phase_idx, number, number_partial,
+            aero_rep_int_data, aero_rep_float_data, aero_rep_env_data);
+        aero_rep_modal_binned_mass_get_aero_phase_mass__kg_m3(
+            model_data, aero_phase_idx, mass, mass_partial, aero_rep_int_data,
+            aero_rep_float_data, aero_rep_env_data);
+        aero_rep_modal_binned_mass_get_aero_phase_avg_MW__kg_mol(
+            model_data, aero_phase_idx, MW, MW_partial, aero_rep_int_data,
+            aero_rep_float_data, aero_rep_env_data);
+        break;
+      case AERO_REP_SINGLE_PARTICLE:
+        aero_rep_single_particle_get_effective_radius__m(
+            model_data, aero_phase_idx, radius, radius_partial,
+            aero_rep_int_data, aero_rep_float_data, aero_rep_env_data);
+        aero_rep_single_particle_get_number_conc__n_m3(
+            model_data, aero_phase_idx, number, number_partial,
+            aero_rep_int_data, aero_rep_float_data, aero_rep_env_data);
+        aero_rep_single_particle_get_aero_phase_mass__kg_m3(
+            model_data, aero_phase_idx, mass, mass_partial, aero_rep_int_data,
+            aero_rep_float_data, aero_rep_env_data);
+        aero_rep_single_particle_get_aero_phase_avg_MW__kg_mol(
+            model_data, aero_phase_idx, MW, MW_partial, aero_rep_int_data,
+            aero_rep_float_data, aero_rep_env_data);
+        break;
+    }
+  }
+}
+
 /** \brief Get state array elements used by aerosol representation functions
  *
  * \param model_data A pointer to the model data
@@ -140,11 +411,14 @@ void aero_rep_update_env_state(ModelData *model_data) {
   }
 }
 
-/** \brief Update the aerosol representations for a new state
+/** \brief Update the aerosol representations and the cached aerosol
+ *         properties for a new state
  *
  * \param model_data Pointer to the model data
+ * \param calc_partials Flag indicating whether to update the partial
+ *                      derivatives of the cached properties
  */
-void aero_rep_update_state(ModelData *model_data) {
+static void aero_rep_update(ModelData *model_data, bool calc_partials) {
   // Get the number of aerosol representations
   int n_aero_rep = model_data->n_aero_rep;
 
@@ -178,9 +452,38 @@ void aero_rep_update_state(ModelData *model_data) {
                                               aero_rep_env_data);
         break;
     }
+
+    // Update the cached properties of the phase instances used by the
+    // reactions
+    if (model_data->aero_phase_inst_jac_idx != NULL)
+      aero_rep_update_cache(model_data, i_aero_rep, aero_rep_type,
+                            aero_rep_int_data, aero_rep_float_data,
+                            aero_rep_env_data, calc_partials);
   }
 }
 
+/** \brief Update the aerosol representations for a new state
+ *
+ * \param model_data Pointer to the model data
+ */
+void aero_rep_update_state(ModelData *model_data) {
+  aero_rep_update(model_data, false);
+}
+
+/** \brief Update the aerosol representations for a new state, including the
+ *         cached partial derivatives of aerosol properties
+ *
+ * Updates the cached effective radius, number concentration, phase mass and
+ * average MW of each phase instance used by the reactions, along with their
+ * partial derivatives with respect to the state variables, in one pass. Use
+ * instead of \c aero_rep_update_state() when the Jacobian is calculated.
+ *
+ * \param model_data Pointer to the model data
+ */
+void aero_rep_update_state_and_partials(ModelData *model_data) {
+  aero_rep_update(model_data, true);
+}
+
 /** \brief Get the effective particle radius, \f$r_{eff}\f$ (m)
  *
  * Calculates effective particle radius \f$r_{eff}\f$ (m), as well as the set of
@@ -494,10 +797,15 @@ void aero_rep_update_data(int cell_id, int *aero_rep_id,
                           void *solver_data) {
   ModelData *model_data =
       (ModelData *)&(((SolverData *)solver_data)->model_data);
+  SolverTrace *trace = &(((SolverData *)solver_data)->trace);
+  double start__s = trace->events != NULL ? solver_timer_now() : 0.0;
+
+  // The environment-dependent data of the grid cell must be recalculated
+  model_data->env_cache[cell_id * model_data->n_env_cache] = NAN;
 
   // Point to the environment-dependent data for the grid cell
   model_data->grid_cell_aero_rep_env_data = &(
-      model_data->aero_rep_env_data[cell_id * model_data->n_aero_rep_env_data]);
+      model_data->aero_rep_env_data[cell_id * model_data->n_cell_env_data]);
 
   // Get the number of aerosol representations
   int n_aero_rep = model_data->n_aero_rep;
@@ -534,9 +842,12 @@ void aero_rep_update_data(int cell_id, int *aero_rep_id,
               aero_rep_env_data);
           break;
       }
-      if (found) return;
+      if (found) break;
     }
   }
+  if (trace->events != NULL)
+    solver_trace_add(trace, SOLVER_TRACE_AERO_REP_UPDATE_DATA, start__s,
+                     solver_timer_now());
 }
 
 /** \brief Print the aerosol representation data
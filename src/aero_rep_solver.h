@@ -20,6 +20,7 @@ int aero_rep_get_used_jac_elem(ModelData *model_data, int aero_rep_idx,
 void aero_rep_get_dependencies(ModelData *model_data, bool *state_flags);
 void aero_rep_update_env_state(ModelData *model_data);
 void aero_rep_update_state(ModelData *model_data);
+void aero_rep_update_state_and_partials(ModelData *model_data);
 void aero_rep_get_effective_radius__m(ModelData *model_data, int aero_rep_idx,
                                       int aero_phase_idx, double *radius,
                                       double *partial_deriv);
@@ -40,6 +41,9 @@ void aero_rep_get_aero_phase_avg_MW__kg_mol(ModelData *model_data,
 void aero_rep_print_data(void *solver_data);
 
 /* Setup functions */
+void aero_rep_initialize_cache(ModelData *model_data);
+void aero_rep_build_cache(ModelData *model_data);
+void aero_rep_free_cache(ModelData *model_data);
 void aero_rep_add_condensed_data(int aero_rep_type, int n_int_param,
                                  int n_float_param, int n_env_param,
                                  int *int_param, double *float_param,
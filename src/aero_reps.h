@@ -18,6 +18,8 @@ int aero_rep_modal_binned_mass_get_used_jac_elem(ModelData *model_data,
                                                  int *aero_rep_int_data,
                                                  double *aero_rep_float_data,
                                                  bool *jac_struct);
+int aero_rep_modal_binned_mass_get_num_phase_instances(
+    int *aero_rep_int_data, double *aero_rep_float_data);
 void aero_rep_modal_binned_mass_get_dependencies(int *aero_rep_int_data,
                                                  double *aero_rep_float_data,
                                                  bool *state_flags);
@@ -71,6 +73,8 @@ int aero_rep_single_particle_get_used_jac_elem(ModelData *model_data,
                                                int *aero_rep_int_data,
                                                double *aero_rep_float_data,
                                                bool *jac_struct);
+int aero_rep_single_particle_get_num_phase_instances(
+    int *aero_rep_int_data, double *aero_rep_float_data);
 void aero_rep_single_particle_get_dependencies(int *aero_rep_int_data,
                                                double *aero_rep_float_data,
                                                bool *state_flags);
@@ -127,6 +127,26 @@ int aero_rep_modal_binned_mass_get_used_jac_elem(ModelData *model_data,
   return num_flagged_elem;
 }
 
+/** \brief Get the number of aerosol phase instances in the representation
+ *
+ * Each mode or bin holds one instance of every aerosol phase in its section.
+ *
+ * \param aero_rep_int_data Pointer to the aerosol representation integer data
+ * \param aero_rep_float_data Pointer to the aerosol representation
+ *                            floating-point data
+ * \return Number of aerosol phase instances
+ */
+int aero_rep_modal_binned_mass_get_num_phase_instances(
+    int *aero_rep_int_data, double *aero_rep_float_data) {
+  int *int_data = aero_rep_int_data;
+
+  int num_instances = 0;
+  for (int i_section = 0; i_section < NUM_SECTION_; i_section++)
+    num_instances += NUM_BINS_(i_section) * NUM_PHASE_(i_section);
+
+  return num_instances;
+}
+
 /** \brief Flag elements on the state array used by this aerosol representation
  *
  * The modal mass aerosol representation functions do not use state array values
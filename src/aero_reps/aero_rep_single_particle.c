@@ -66,6 +66,23 @@ int aero_rep_single_particle_get_used_jac_elem(ModelData *model_data,
   return n_jac_elem;
 }
 
+/** \brief Get the number of aerosol phase instances in the representation
+ *
+ * Each particle holds one instance of every aerosol phase in the
+ * representation.
+ *
+ * \param aero_rep_int_data Pointer to the aerosol representation integer data
+ * \param aero_rep_float_data Pointer to the aerosol representation
+ *                            floating-point data
+ * \return Number of aerosol phase instances
+ */
+int aero_rep_single_particle_get_num_phase_instances(
+    int *aero_rep_int_data, double *aero_rep_float_data) {
+  int *int_data = aero_rep_int_data;
+
+  return NUM_PHASE_ * MAX_PARTICLES_;
+}
+
 /** \brief Flag elements on the state array used by this aerosol representation
  *
  * The single particle aerosol representation functions do not use state array
@@ -0,0 +1,129 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Memory arena functions
+ *
+ */
+/** \file
+ * \brief Memory arena functions
+ */
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <sys/mman.h>
+#else
+#define _POSIX_C_SOURCE 200112L
+#endif
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Size of huge pages used to round mapped blocks (2 MiB on x86-64 and
+// most aarch64 systems)
+#define ARENA_HUGE_PAGE_SIZE_ ((size_t)2 * 1024 * 1024)
+
+// Smallest block added when the first block runs out
+#define ARENA_MIN_BLOCK_SIZE_ ((size_t)64 * 1024)
+
+// Bytes reserved for the block header at the start of each block
+#define ARENA_HEADER_SIZE_ (arena_aligned_size(sizeof(ArenaBlock)))
+
+size_t arena_aligned_size(size_t size) {
+  return (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+}
+
+// Map a block with huge pages (Linux only)
+static ArenaBlock *map_block(size_t bytes, ArenaPageType pages,
+                             int *used_huge_pages) {
+#ifdef __linux__
+  size_t mapped_size = (bytes + ARENA_HUGE_PAGE_SIZE_ - 1) /
+                       ARENA_HUGE_PAGE_SIZE_ * ARENA_HUGE_PAGE_SIZE_;
+  void *mem = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (pages == ARENA_PAGES_EXPLICIT) {
+    mem = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mem != MAP_FAILED) *used_huge_pages = 1;
+  }
+#endif
+  if (mem == MAP_FAILED) {
+    mem = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+    if (madvise(mem, mapped_size, MADV_HUGEPAGE) == 0) *used_huge_pages = 1;
+#endif
+  }
+  ArenaBlock *block = (ArenaBlock *)mem;
+  block->is_mapped = 1;
+  block->mapped_size = mapped_size;
+  return block;
+#else
+  return NULL;
+#endif
+}
+
+// Reserve a new block with at least size usable bytes
+static int add_block(Arena *arena, size_t size) {
+  size_t bytes = ARENA_HEADER_SIZE_ + arena_aligned_size(size);
+  ArenaBlock *block = NULL;
+
+  if (arena->pages != ARENA_PAGES_DEFAULT)
+    block = map_block(bytes, arena->pages, &(arena->used_huge_pages));
+  if (block == NULL) {
+    // Mapped memory is zeroed by the kernel, so only this memory needs
+    // clearing
+    void *mem = NULL;
+    if (posix_memalign(&mem, ARENA_ALIGNMENT, bytes) != 0) return 0;
+    block = (ArenaBlock *)mem;
+    memset(block, 0, bytes);
+    block->is_mapped = 0;
+    block->mapped_size = bytes;
+  }
+  block->size = block->mapped_size - ARENA_HEADER_SIZE_;
+  block->used = 0;
+  block->next = arena->current;
+  arena->current = block;
+  arena->total_bytes += block->mapped_size;
+  return 1;
+}
+
+int arena_initialize(Arena *arena, size_t size, ArenaPageType pages) {
+  arena->current = NULL;
+  arena->pages = pages;
+  arena->used_huge_pages = 0;
+  arena->total_bytes = 0;
+  return add_block(arena, size > 0 ? size : ARENA_ALIGNMENT);
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+  size = arena_aligned_size(size > 0 ? size : 1);
+  ArenaBlock *block = arena->current;
+  if (block == NULL || block->size - block->used < size) {
+    if (!add_block(arena, size > ARENA_MIN_BLOCK_SIZE_ ? size
+                                                      : ARENA_MIN_BLOCK_SIZE_))
+      return NULL;
+    block = arena->current;
+  }
+  void *ptr = (char *)block + ARENA_HEADER_SIZE_ + block->used;
+  block->used += size;
+  return ptr;
+}
+
+void arena_free(Arena *arena) {
+  ArenaBlock *block = arena->current;
+  while (block != NULL) {
+    ArenaBlock *next = block->next;
+#ifdef __linux__
+    if (block->is_mapped) {
+      munmap(block, block->mapped_size);
+      block = next;
+      continue;
+    }
+#endif
+    free(block);
+    block = next;
+  }
+  arena->current = NULL;
+  arena->total_bytes = 0;
+}
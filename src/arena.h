@@ -0,0 +1,90 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the memory arena and related functions
+ *
+ */
+/** \file
+ * \brief Header for the memory arena and related functions
+ */
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <stddef.h>
+
+/* Alignment of every arena allocation (bytes, one cache line and the width
+ * of the widest SIMD registers) */
+#define ARENA_ALIGNMENT 64
+
+/* Page backing for arena memory (the values must match the
+ * CAMP_HUGE_PAGES_* parameters in the camp_camp_solver_data module) */
+typedef enum {
+  ARENA_PAGES_DEFAULT,      // Regular pages from the C allocator
+  ARENA_PAGES_TRANSPARENT,  // Anonymous mapping advised for transparent huge
+                            // pages
+  ARENA_PAGES_EXPLICIT      // Mapping from the reserved huge page pool
+                            // (MAP_HUGETLB), falling back to transparent
+                            // huge pages if the pool is empty
+} ArenaPageType;
+
+/* A block of arena memory */
+typedef struct ArenaBlock_ {
+  struct ArenaBlock_ *next;  // Previously filled block
+  size_t size;               // Usable bytes in the block
+  size_t used;               // Bytes handed out
+  int is_mapped;             // Flag indicating the block was mapped with
+                             // mmap() (0 = false; 1 = true)
+  size_t mapped_size;        // Bytes mapped (including this header)
+} ArenaBlock;
+
+/* Memory arena
+ *
+ * Arrays that live as long as the arena are handed out from large blocks
+ * with bump allocation, so they are contiguous, aligned to
+ * \c ARENA_ALIGNMENT and released all at once. The first block is sized by
+ * the caller; later blocks are only added if that estimate runs out.
+ */
+typedef struct {
+  ArenaBlock *current;     // Block being filled
+  ArenaPageType pages;     // Requested page backing
+  int used_huge_pages;     // Flag indicating whether any block is backed by
+                           // huge pages (0 = false; 1 = true)
+  size_t total_bytes;      // Total bytes reserved by all blocks
+} Arena;
+
+/** \brief Round a number of bytes up to the arena alignment
+ *
+ * \param size Number of bytes
+ * \return Bytes used in the arena for an allocation of \c size bytes
+ */
+size_t arena_aligned_size(size_t size);
+
+/** \brief Initialize an arena and reserve its first block
+ *
+ * Huge pages are only available on Linux; other systems use regular pages.
+ *
+ * \param arena Pointer to the Arena object
+ * \param size Expected number of bytes to allocate (see
+ *             arena_aligned_size())
+ * \param pages Requested page backing
+ * \return Flag indicating success (0 = false; 1 = true)
+ */
+int arena_initialize(Arena *arena, size_t size, ArenaPageType pages);
+
+/** \brief Allocate zero-initialized memory from an arena
+ *
+ * \param arena Pointer to the Arena object
+ * \param size Number of bytes
+ * \return Pointer to memory aligned to \c ARENA_ALIGNMENT, or NULL if no
+ *         more memory could be reserved
+ */
+void *arena_alloc(Arena *arena, size_t size);
+
+/** \brief Release all memory allocated from an arena
+ *
+ * \param arena Pointer to the Arena object
+ */
+void arena_free(Arena *arena);
+
+#endif
@@ -13,6 +13,13 @@
 
 #include <time.h>
 #include "Jacobian.h"
+#include "arena.h"
+#include "cost_profile.h"
+#include "host_state.h"
+#include "hw_counters.h"
+#include "solver_timers.h"
+#include "solver_trace.h"
+#include "subsystems.h"
 #include "time_derivative.h"
 
 /* SUNDIALS Header files with a description of contents used */
@@ -63,6 +70,54 @@ typedef struct {
   int param_id;   // sub model Jacobian id
 } JacMap;
 
+/* Rate constant lookup table */
+typedef struct {
+  int n_temp;            // number of temperature nodes (0 = table not used)
+  int n_press;           // number of pressure nodes
+  double temp_min__K;    // lowest tabulated temperature (K)
+  double temp_max__K;    // highest tabulated temperature (K)
+  double log_press_min;  // log of the lowest tabulated pressure (Pa)
+  double log_press_max;  // log of the highest tabulated pressure (Pa)
+  double d_temp;         // temperature node spacing (K)
+  double d_log_press;    // log pressure node spacing
+  double tolerance;      // maximum allowed relative interpolation error
+  double max_rel_error;  // largest relative error of the tabulated reactions
+  int n_rxn;             // number of tabulated reactions
+  int n_values;          // number of tabulated values per node
+  int *env_value_idx;    // index in the tabulated values of each reaction
+                         // environment-dependent parameter (-1 for parameters
+                         // that are not tabulated)
+  double *log_values;    // log of the tabulated values at each (T, P) node
+  double *cell_values;   // interpolated values for the current grid cell
+  bool cell_in_range;    // flag indicating whether the current grid cell is
+                         // within the tabulated range
+} RateTable;
+
+/* Sentinel for missing ids in the compact reaction data */
+#define RXN_COMPACT_NO_ID 0xFFFF
+
+/* Compact encoding of the reaction data used to calculate the time derivative
+ * and Jacobian
+ *
+ * Built once the solver ids are known, for reactions with mass-action rates
+ * and only when every id fits in 16 bits. Each record holds 0-based ids:
+ *   n_var_react, n_prod, reactant state ids [n_var_react],
+ *   product state ids [n_prod], derivative ids [n_var_react + n_prod],
+ *   Jacobian ids [n_var_react * (n_var_react + n_prod)]
+ * with missing ids set to RXN_COMPACT_NO_ID. Records that fit in a cache line
+ * do not cross one.
+ */
+typedef struct {
+  int n_rxn;              // number of encoded reactions (0 = not used)
+  int n_ids;              // length of ids (including padding)
+  int n_yields;           // length of yields
+  int *rxn_offsets;       // start of the record for each reaction in ids
+                          // (-1 for reactions that are not encoded)
+  int *yield_offsets;     // start of the yields for each reaction in yields
+  unsigned short *ids;    // records for the encoded reactions
+  double *yields;         // product yields for the encoded reactions
+} RxnCompactData;
+
 /* Model data structure */
 typedef struct {
   int n_per_cell_state_var;        // number of state variables per grid cell
@@ -78,13 +133,24 @@ typedef struct {
                     // integration tolerances
   int *var_type;    // pointer to array of state variable types (solver,
                     // constant, PSSA)
+  int *dep_var_ids;    // State variable index of each solver variable in a
+                       // grid cell (gather/scatter map between the solver
+                       // and state arrays)
+  int var_order;       // Order of the solver variables (a SpeciesOrderType
+                       // value)
+  int *const_var_ids;  // State variable index of each constant species in a
+                       // grid cell
+  int n_per_cell_const_var;  // number of constant species per grid cell
 #ifdef CAMP_USE_SUNDIALS
-  SUNMatrix J_init;    // sparse solver Jacobian matrix with used elements
-                       // initialized to 1.0
+  int *jac_cell_col_ptrs;  // Solver Jacobian column pointers for one grid
+                           // cell (the sparsity pattern is shared by all
+                           // cells)
+  int *jac_cell_row_ids;   // Solver Jacobian row indices for one grid cell
   SUNMatrix J_rxn;     // Matrix for Jacobian contributions from reactions
   SUNMatrix J_params;  // Matrix for Jacobian contributions from sub model
                        // parameter calculations
-  SUNMatrix J_solver;  // Solver Jacobian
+  double *J_solver_data;  // Solver Jacobian values for all grid cells (one
+                          // block per cell in the shared sparsity pattern)
   N_Vector J_state;    // Last state used to calculate the Jacobian
   N_Vector J_deriv;    // Last derivative used to calculate the Jacobian
   N_Vector J_tmp;      // Working vector (size of J_state and J_deriv)
@@ -138,6 +204,13 @@ typedef struct {
                              // for the current grid cell
   int n_rxn_env_data;        // Number of reaction environmental parameters
                              // from all reactions
+  RateTable rate_table;      // Rate constant lookup table
+  RxnCompactData rxn_compact;  // Compact reaction data for the solver
+  int *rxn_active_ids;       // Ids of the reactions that contribute to the
+                             // derivative and Jacobian in each grid cell
+                             // (n_rxn per grid cell)
+  int *n_active_rxn;         // Number of active reactions in each grid cell
+  CostProfile cost_profile;  // Optional reaction and sub-model cost profile
   int n_aero_phase;          // Number of aerosol phases
   int n_added_aero_phases;   // The number of aerosol phases whose data has
                              // been added to the aerosol phase data arrays
@@ -162,7 +235,39 @@ typedef struct {
                           // dependent data for the current grid cell
   int n_aero_rep_env_data;  // Number of aerosol representation environmental
                             // parameters for all aerosol representations
-  int n_sub_model;          // Number of sub models
+  int n_aero_phase_inst;    // Number of aerosol phase instances in all
+                            // aerosol representations
+  int *aero_rep_phase_inst_idx;  // Index of the first phase instance of each
+                                 // aerosol representation in the cached
+                                 // aerosol property arrays (n_aero_rep + 1)
+  int *aero_phase_inst_num_jac_elem;  // Number of partial derivatives for each
+                                      // phase instance (-1 for instances not
+                                      // used by any reaction)
+  int *aero_phase_inst_jac_idx;  // Offset of the partial derivatives for each
+                                 // phase instance in the cached partial
+                                 // derivative arrays
+  int *aero_phase_inst_conc_type;  // Aerosol concentration type for each
+                                   // phase instance
+  double *grid_cell_aero_eff_radius__m;  // Effective radius (m) of each phase
+                                         // instance in the current grid cell
+  double *grid_cell_aero_number_conc__n_m3;  // Particle number concentration
+                                             // (#/m3) of each phase instance
+                                             // in the current grid cell
+  double *grid_cell_aero_phase_mass__kg_m3;  // Aerosol phase mass (kg/m3) of
+                                             // each phase instance in the
+                                             // current grid cell
+  double *grid_cell_aero_phase_avg_MW__kg_mol;  // Average MW (kg/mol) of each
+                                                // phase instance in the
+                                                // current grid cell
+  double *grid_cell_aero_eff_radius_jac_elem;  // Partial derivatives of the
+                                               // cached effective radii
+  double *grid_cell_aero_number_conc_jac_elem;  // Partial derivatives of the
+                                                // cached number concentrations
+  double *grid_cell_aero_phase_mass_jac_elem;  // Partial derivatives of the
+                                               // cached aerosol phase masses
+  double *grid_cell_aero_phase_avg_MW_jac_elem;  // Partial derivatives of the
+                                                 // cached average MWs
+  int n_sub_model;         // Number of sub models
   int n_added_sub_models;   // The number of sub models whose data has been
                             // added to the sub model data arrays
   int *sub_model_int_data;  // Pointer to sub model integer parameters
@@ -176,8 +281,37 @@ typedef struct {
                                  // for the current grid cell
   int n_sub_model_env_data;      // Number of sub model environmental parameters
                                  // from all sub models
+  int n_cell_env_data;  // Distance between the environment-dependent data of
+                        // two grid cells (reaction, aerosol representation
+                        // and sub model data are stored together per cell)
+  double *env_cache;    // Temperature, pressure and constant species
+                        // concentrations of each grid cell when its
+                        // environment-dependent data was last calculated
+                        // (NaN when it must be recalculated)
+  int n_env_cache;      // Distance between the cached values of two grid
+                        // cells
+  Arena arena;  // Aligned storage for the variable, reaction, aerosol and
+                // sub model data arrays and the solver vectors
 } ModelData;
 
+/* Per-cell solver statistics for multi-cell solves
+ *
+ * These are reset at the beginning of each call to solver_run().
+ */
+typedef struct {
+  int *rhs_contribs;         // Reaction derivative contributions calculated
+  int *neg_conc_rejections;  // State updates rejected for negative
+                             // concentrations in the cell
+  int *guess_helper_activations;  // Guess helper calls made because of
+                                  // negative predicted concentrations in the
+                                  // cell
+  double *time__s;   // Time spent on the cell in f() and Jac() (s)
+  double *err_norm;  // Weighted RMS norm of the local error estimate for the
+                     // cell at the last step
+  int *env_updates;  // Environment-dependent data updates for the cell (0
+                     // when its environmental state was unchanged)
+} CellStats;
+
 /* Solver data structure */
 typedef struct {
 #ifdef CAMP_USE_SUNDIALS
@@ -188,10 +322,12 @@ typedef struct {
                               // calculating deriv
   Jacobian jac;               // CAMP Jacobian structure for use in
                               // calculating the Jacobian
+  Subsystems subsystems;      // Decomposition of the solver variables into
+                              // coupled blocks
   N_Vector deriv;      // used to calculate the derivative outside the solver
+  N_Vector jac_tmp1;   // working vector for calls to Jac() outside the solver
+  N_Vector jac_tmp2;   // working vector for calls to Jac() outside the solver
   SUNMatrix J;         // Jacobian matrix
-  SUNMatrix J_guess;   // Jacobian matrix for improving guesses sent to linear
-                       // solver
   bool curr_J_guess;   // Flag indicating the Jacobian used by the guess helper
                        // is current
   realtype J_guess_t;  // Last time (t) for which J_guess was calculated
@@ -200,13 +336,20 @@ typedef struct {
   int output_precision;  // Flag indicating whether to output precision loss
   int use_deriv_est;     // Flag indicating whether to use an estimated
                          // derivative in the f() calculations
+  SolverTimers timers;   // Time spent in each phase of solving
+  int phase_timing;      // Flag indicating whether to time the per-cell
+                         // solver phases and grid cells (on by default)
+  CellStats cell_stats;  // Solver statistics for each grid cell
+  int *cell_active;      // Flag for each grid cell indicating whether it is
+                         // integrated (0 = kept at its initial state)
+  int n_explicit_cells;  // Number of quiescent grid cells updated explicitly
+                         // during the current call to solver_run()
+  double quiescence_tol;  // Fraction of the integration tolerances below
+                          // which a grid cell's change over a time step is
+                          // applied explicitly (0 = never)
 #ifdef CAMP_DEBUG
   booleantype debug_out;  // Output debugging information during solving
   booleantype eval_Jac;   // Evalute Jacobian data during solving
-  int counterDeriv;       // Total calls to f()
-  int counterJac;         // Total calls to Jac()
-  clock_t timeDeriv;      // Compute time for calls to f()
-  clock_t timeJac;        // Compute time for calls to Jac()
   double
       max_loss_precision;  // Maximum loss of precision during last call to f()
 #endif
@@ -216,6 +359,11 @@ typedef struct {
   bool no_solve;  // Flag to indicate whether to run the solver needs to be
                   // run. Set to true when no reactions are present.
   double init_time_step;  // Initial time step (s)
+  SolverTrace trace;      // Optional timeline of solver events
+  HwCounters hw_counters;  // Optional hardware event counts
+  HostStateMap *host_map;  // Host state map used to pack the solver
+                           // variables for the next solve (NULL when they
+                           // are taken from the state array)
 } SolverData;
 
 #endif
@@ -18,7 +18,9 @@
 #include <stdlib.h>
 #include <time.h>
 #include "aero_rep_solver.h"
+#include "memory_report.h"
 #include "rxn_solver.h"
+#include "species_order.h"
 #include "sub_model_solver.h"
 #ifdef CAMP_USE_GPU
 #include "cuda/camp_gpu_solver.h"
@@ -78,6 +80,8 @@
  *                                parameters
  * \param n_sub_model_env_param Total number of environment-dependent sub model
  *                              parameters
+ * \param huge_pages Page type for the model data (an ArenaPageType value)
+ * \param var_order Order of the solver variables (a SpeciesOrderType value)
  * \return Pointer to the new SolverData object
  */
 void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
@@ -87,7 +91,8 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
                  int n_aero_rep, int n_aero_rep_int_param,
                  int n_aero_rep_float_param, int n_aero_rep_env_param,
                  int n_sub_model, int n_sub_model_int_param,
-                 int n_sub_model_float_param, int n_sub_model_env_param) {
+                 int n_sub_model_float_param, int n_sub_model_env_param,
+                 int huge_pages, int var_order) {
   // Create the SolverData object
   SolverData *sd = (SolverData *)malloc(sizeof(SolverData));
   if (sd == NULL) {
@@ -111,14 +116,81 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
   // Use the Jacobian estimated derivative in f() by default
   sd->use_deriv_est = 1;
 
+  // Start with empty solver timers, timing the per-cell phases
+  solver_timers_reset(&(sd->timers));
+  sd->phase_timing = 1;
+
+  // Start with event tracing turned off
+  solver_trace_initialize(&(sd->trace));
+
+  // Start with hardware event counting turned off
+  hw_counters_initialize(&(sd->hw_counters));
+
+  // Start with the solver variables taken from the state array
+  sd->host_map = NULL;
+
+#ifdef CAMP_USE_SUNDIALS
+  // Allocate space for the per-cell solver statistics
+  sd->cell_stats.rhs_contribs = (int *)calloc(n_cells, sizeof(int));
+  sd->cell_stats.neg_conc_rejections = (int *)calloc(n_cells, sizeof(int));
+  sd->cell_stats.guess_helper_activations =
+      (int *)calloc(n_cells, sizeof(int));
+  sd->cell_stats.time__s = (double *)calloc(n_cells, sizeof(double));
+  sd->cell_stats.err_norm = (double *)calloc(n_cells, sizeof(double));
+  sd->cell_stats.env_updates = (int *)calloc(n_cells, sizeof(int));
+  if (sd->cell_stats.rhs_contribs == NULL ||
+      sd->cell_stats.neg_conc_rejections == NULL ||
+      sd->cell_stats.guess_helper_activations == NULL ||
+      sd->cell_stats.time__s == NULL || sd->cell_stats.err_norm == NULL ||
+      sd->cell_stats.env_updates == NULL) {
+    printf("\n\nERROR allocating space for per-cell solver statistics\n\n");
+    exit(EXIT_FAILURE);
+  }
+
+  // Start with all grid cells integrated and no explicit updates of
+  // quiescent grid cells
+  sd->cell_active = (int *)malloc(n_cells * sizeof(int));
+  if (sd->cell_active == NULL) {
+    printf("\n\nERROR allocating space for grid cell flags\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i_cell = 0; i_cell < n_cells; ++i_cell) sd->cell_active[i_cell] = 1;
+  sd->n_explicit_cells = 0;
+  sd->quiescence_tol = 0.0;
+#endif
+
   // Save the number of state variables per grid cell
   sd->model_data.n_per_cell_state_var = n_state_var;
 
   // Set number of cells to compute simultaneously
   sd->model_data.n_cells = n_cells;
 
+  // Reserve a block for the model data arrays allocated below, so that they
+  // are contiguous, aligned for SIMD loads and, if requested, backed by huge
+  // pages. The size is an estimate (later arrays go in a new block if it is
+  // too small).
+  Arena *arena = &(sd->model_data.arena);
+  size_t env_bytes = arena_aligned_size(n_rxn_env_param * sizeof(double)) +
+                     arena_aligned_size(n_aero_rep_env_param * sizeof(double)) +
+                     arena_aligned_size(n_sub_model_env_param * sizeof(double));
+  size_t arena_size =
+      (3 * n_state_var + n_rxn_int_param + 4 * n_rxn + n_cells * (n_rxn + 1) +
+       n_aero_phase_int_param + 2 * n_aero_phase + n_aero_rep_int_param +
+       4 * n_aero_rep + n_sub_model_int_param + 4 * n_sub_model) *
+          sizeof(int) +
+      (n_rxn_float_param + n_aero_phase_float_param + n_aero_rep_float_param +
+       n_sub_model_float_param + 3 * n_cells * n_state_var +
+       n_cells * CAMP_NUM_ENV_PARAM_) *
+          sizeof(double) +
+      n_cells * env_bytes + 32 * ARENA_ALIGNMENT;
+  if (arena_initialize(arena, arena_size, (ArenaPageType)huge_pages) != 1) {
+    printf("\n\nERROR allocating space for the model data\n\n");
+    exit(EXIT_FAILURE);
+  }
+
   // Add the variable types to the solver data
-  sd->model_data.var_type = (int *)malloc(n_state_var * sizeof(int));
+  sd->model_data.var_type =
+      (int *)arena_alloc(arena, n_state_var * sizeof(int));
   if (sd->model_data.var_type == NULL) {
     printf("\n\nERROR allocating space for variable types\n\n");
     exit(EXIT_FAILURE);
@@ -131,8 +203,32 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
   for (int i = 0; i < n_state_var; i++)
     if (var_type[i] == CHEM_SPEC_VARIABLE) n_dep_var++;
 
-  // Save the number of solver variables per grid cell
+  // Save the number of solver variables per grid cell and their requested
+  // order (the order is set when the Jacobian structure is known)
   sd->model_data.n_per_cell_dep_var = n_dep_var;
+  sd->model_data.var_order = var_order;
+
+  // Build the gather/scatter maps from solver variables and constant species
+  // to their state variables
+  int n_const_var = 0;
+  for (int i = 0; i < n_state_var; i++)
+    if (var_type[i] == CHEM_SPEC_CONSTANT) n_const_var++;
+  sd->model_data.n_per_cell_const_var = n_const_var;
+  sd->model_data.dep_var_ids =
+      (int *)arena_alloc(arena, (n_dep_var + 1) * sizeof(int));
+  sd->model_data.const_var_ids =
+      (int *)arena_alloc(arena, (n_const_var + 1) * sizeof(int));
+  if (sd->model_data.dep_var_ids == NULL ||
+      sd->model_data.const_var_ids == NULL) {
+    printf("\n\nERROR allocating space for solver variable ids\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i = 0, i_dep = 0, i_const = 0; i < n_state_var; i++) {
+    if (var_type[i] == CHEM_SPEC_VARIABLE)
+      sd->model_data.dep_var_ids[i_dep++] = i;
+    else if (var_type[i] == CHEM_SPEC_CONSTANT)
+      sd->model_data.const_var_ids[i_const++] = i;
+  }
 
 #ifdef CAMP_USE_SUNDIALS
   // Set up a TimeDerivative object to use during solving
@@ -142,46 +238,104 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
   }
 
   // Set up the solver variable array and helper derivative array
-  sd->y = N_VNew_Serial(n_dep_var * n_cells);
-  sd->deriv = N_VNew_Serial(n_dep_var * n_cells);
+  // (their data is owned by the model data arena)
+  sd->y = N_VMake_Serial(
+      n_dep_var * n_cells,
+      (realtype *)arena_alloc(arena, n_dep_var * n_cells * sizeof(realtype)));
+  sd->deriv = N_VMake_Serial(
+      n_dep_var * n_cells,
+      (realtype *)arena_alloc(arena, n_dep_var * n_cells * sizeof(realtype)));
+
+  // The working vectors for Jac() are set up during solver initialization
+  sd->jac_tmp1 = NULL;
+  sd->jac_tmp2 = NULL;
+
+  // The subsystem decomposition is set up when it is first requested
+  sd->subsystems.num_blocks = 0;
+  sd->subsystems.num_groups = 0;
+  sd->subsystems.block_ptrs = NULL;
+  sd->subsystems.spec_ids = NULL;
+  sd->subsystems.spec_block = NULL;
+  sd->subsystems.block_group = NULL;
+  sd->subsystems.num_block_deps = NULL;
+
+  // The Jacobian sparsity pattern is set up during solver initialization
+  sd->model_data.jac_cell_col_ptrs = NULL;
+  sd->model_data.jac_cell_row_ids = NULL;
+  sd->model_data.J_solver_data = NULL;
 #endif
 
   // Allocate space for the reaction data and set the number
   // of reactions (including one int for the number of reactions
   // and one int per reaction to store the reaction type)
   sd->model_data.rxn_int_data =
-      (int *)malloc((n_rxn_int_param + n_rxn) * sizeof(int));
+      (int *)arena_alloc(arena, (n_rxn_int_param + n_rxn) * sizeof(int));
   if (sd->model_data.rxn_int_data == NULL) {
     printf("\n\nERROR allocating space for reaction integer data\n\n");
     exit(EXIT_FAILURE);
   }
   sd->model_data.rxn_float_data =
-      (double *)malloc(n_rxn_float_param * sizeof(double));
+      (double *)arena_alloc(arena, n_rxn_float_param * sizeof(double));
   if (sd->model_data.rxn_float_data == NULL) {
     printf("\n\nERROR allocating space for reaction float data\n\n");
     exit(EXIT_FAILURE);
   }
-  sd->model_data.rxn_env_data =
-      (double *)calloc(n_cells * n_rxn_env_param, sizeof(double));
+
+  // The environment-dependent data of the reactions, aerosol representations
+  // and sub models is stored together for each grid cell (each part starting
+  // on a cache line), so that cells are laid out one after the other
+  int n_rxn_env_size =
+      arena_aligned_size(n_rxn_env_param * sizeof(double)) / sizeof(double);
+  int n_aero_rep_env_size =
+      arena_aligned_size(n_aero_rep_env_param * sizeof(double)) /
+      sizeof(double);
+  int n_sub_model_env_size =
+      arena_aligned_size(n_sub_model_env_param * sizeof(double)) /
+      sizeof(double);
+  sd->model_data.n_cell_env_data =
+      n_rxn_env_size + n_aero_rep_env_size + n_sub_model_env_size;
+  sd->model_data.rxn_env_data = (double *)arena_alloc(
+      arena, n_cells * sd->model_data.n_cell_env_data * sizeof(double));
   if (sd->model_data.rxn_env_data == NULL) {
     printf(
         "\n\nERROR allocating space for environment-dependent "
         "data\n\n");
     exit(EXIT_FAILURE);
   }
+  sd->model_data.aero_rep_env_data =
+      sd->model_data.rxn_env_data + n_rxn_env_size;
+  sd->model_data.sub_model_env_data =
+      sd->model_data.aero_rep_env_data + n_aero_rep_env_size;
+
+  // The environment-dependent data of a grid cell only needs to be
+  // recalculated when its environmental state or constant species change
+  sd->model_data.n_env_cache = CAMP_NUM_ENV_PARAM_ + n_const_var;
+  sd->model_data.env_cache = (double *)arena_alloc(
+      arena, n_cells * sd->model_data.n_env_cache * sizeof(double));
+  if (sd->model_data.env_cache == NULL) {
+    printf(
+        "\n\nERROR allocating space for the environmental state "
+        "cache\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i_cell = 0; i_cell < n_cells; ++i_cell)
+    sd->model_data.env_cache[i_cell * sd->model_data.n_env_cache] = NAN;
 
   // Allocate space for the reaction data pointers
-  sd->model_data.rxn_int_indices = (int *)malloc((n_rxn + 1) * sizeof(int *));
+  sd->model_data.rxn_int_indices =
+      (int *)arena_alloc(arena, (n_rxn + 1) * sizeof(int));
   if (sd->model_data.rxn_int_indices == NULL) {
     printf("\n\nERROR allocating space for reaction integer indices\n\n");
     exit(EXIT_FAILURE);
   }
-  sd->model_data.rxn_float_indices = (int *)malloc((n_rxn + 1) * sizeof(int *));
+  sd->model_data.rxn_float_indices =
+      (int *)arena_alloc(arena, (n_rxn + 1) * sizeof(int));
   if (sd->model_data.rxn_float_indices == NULL) {
     printf("\n\nERROR allocating space for reaction float indices\n\n");
     exit(EXIT_FAILURE);
   }
-  sd->model_data.rxn_env_idx = (int *)malloc((n_rxn + 1) * sizeof(int));
+  sd->model_data.rxn_env_idx =
+      (int *)arena_alloc(arena, (n_rxn + 1) * sizeof(int));
   if (sd->model_data.rxn_env_idx == NULL) {
     printf(
         "\n\nERROR allocating space for reaction environment-dependent "
@@ -189,6 +343,25 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
     exit(EXIT_FAILURE);
   }
 
+  // Allocate space for the lists of active reactions in each grid cell
+  sd->model_data.rxn_active_ids =
+      (int *)arena_alloc(arena, (n_cells * n_rxn + 1) * sizeof(int));
+  sd->model_data.n_active_rxn =
+      (int *)arena_alloc(arena, n_cells * sizeof(int));
+  if (sd->model_data.rxn_active_ids == NULL ||
+      sd->model_data.n_active_rxn == NULL) {
+    printf("\n\nERROR allocating space for active reaction lists\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i_cell = 0; i_cell < n_cells; ++i_cell) {
+    sd->model_data.n_active_rxn[i_cell] = n_rxn;
+    for (int i_rxn = 0; i_rxn < n_rxn; ++i_rxn)
+      sd->model_data.rxn_active_ids[i_cell * n_rxn + i_rxn] = i_rxn;
+  }
+
+  // Start with cost profiling turned off
+  cost_profile_initialize(&(sd->model_data.cost_profile), n_rxn);
+
   sd->model_data.n_rxn = n_rxn;
   sd->model_data.n_added_rxns = 0;
   sd->model_data.n_rxn_env_data = 0;
@@ -196,6 +369,24 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
   sd->model_data.rxn_float_indices[0] = 0;
   sd->model_data.rxn_env_idx[0] = 0;
 
+  // The rate constant lookup table is off by default
+  sd->model_data.rate_table.n_temp = 0;
+  sd->model_data.rate_table.n_press = 0;
+  sd->model_data.rate_table.n_rxn = 0;
+  sd->model_data.rate_table.n_values = 0;
+  sd->model_data.rate_table.max_rel_error = 0.0;
+  sd->model_data.rate_table.env_value_idx = NULL;
+  sd->model_data.rate_table.log_values = NULL;
+  sd->model_data.rate_table.cell_values = NULL;
+  sd->model_data.rate_table.cell_in_range = false;
+  sd->model_data.rxn_compact.n_rxn = 0;
+  sd->model_data.rxn_compact.n_ids = 0;
+  sd->model_data.rxn_compact.n_yields = 0;
+  sd->model_data.rxn_compact.rxn_offsets = NULL;
+  sd->model_data.rxn_compact.yield_offsets = NULL;
+  sd->model_data.rxn_compact.ids = NULL;
+  sd->model_data.rxn_compact.yields = NULL;
+
   // If there are no reactions, flag the solver not to run
   sd->no_solve = (n_rxn == 0);
 
@@ -203,13 +394,13 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
   // of aerosol phases (including one int for the number of
   // phases)
   sd->model_data.aero_phase_int_data =
-      (int *)malloc(n_aero_phase_int_param * sizeof(int));
+      (int *)arena_alloc(arena, n_aero_phase_int_param * sizeof(int));
   if (sd->model_data.aero_phase_int_data == NULL) {
     printf("\n\nERROR allocating space for aerosol phase integer data\n\n");
     exit(EXIT_FAILURE);
   }
   sd->model_data.aero_phase_float_data =
-      (double *)malloc(n_aero_phase_float_param * sizeof(double));
+      (double *)arena_alloc(arena, n_aero_phase_float_param * sizeof(double));
   if (sd->model_data.aero_phase_float_data == NULL) {
     printf(
         "\n\nERROR allocating space for aerosol phase floating-point "
@@ -219,13 +410,13 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
 
   // Allocate space for the aerosol phase data pointers
   sd->model_data.aero_phase_int_indices =
-      (int *)malloc((n_aero_phase + 1) * sizeof(int *));
+      (int *)arena_alloc(arena, (n_aero_phase + 1) * sizeof(int));
   if (sd->model_data.aero_phase_int_indices == NULL) {
     printf("\n\nERROR allocating space for reaction integer indices\n\n");
     exit(EXIT_FAILURE);
   }
   sd->model_data.aero_phase_float_indices =
-      (int *)malloc((n_aero_phase + 1) * sizeof(int *));
+      (int *)arena_alloc(arena, (n_aero_phase + 1) * sizeof(int));
   if (sd->model_data.aero_phase_float_indices == NULL) {
     printf("\n\nERROR allocating space for reaction float indices\n\n");
     exit(EXIT_FAILURE);
@@ -242,7 +433,8 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
   // aerosol representation to store the aerosol representation
   // type)
   sd->model_data.aero_rep_int_data =
-      (int *)malloc((n_aero_rep_int_param + n_aero_rep) * sizeof(int));
+      (int *)arena_alloc(arena,
+                         (n_aero_rep_int_param + n_aero_rep) * sizeof(int));
   if (sd->model_data.aero_rep_int_data == NULL) {
     printf(
         "\n\nERROR allocating space for aerosol representation integer "
@@ -250,37 +442,29 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
     exit(EXIT_FAILURE);
   }
   sd->model_data.aero_rep_float_data =
-      (double *)malloc(n_aero_rep_float_param * sizeof(double));
+      (double *)arena_alloc(arena, n_aero_rep_float_param * sizeof(double));
   if (sd->model_data.aero_rep_float_data == NULL) {
     printf(
         "\n\nERROR allocating space for aerosol representation "
         "floating-point data\n\n");
     exit(EXIT_FAILURE);
   }
-  sd->model_data.aero_rep_env_data =
-      (double *)calloc(n_cells * n_aero_rep_env_param, sizeof(double));
-  if (sd->model_data.aero_rep_env_data == NULL) {
-    printf(
-        "\n\nERROR allocating space for aerosol representation "
-        "environmental parameters\n\n");
-    exit(EXIT_FAILURE);
-  }
 
   // Allocate space for the aerosol representation data pointers
   sd->model_data.aero_rep_int_indices =
-      (int *)malloc((n_aero_rep + 1) * sizeof(int *));
+      (int *)arena_alloc(arena, (n_aero_rep + 1) * sizeof(int));
   if (sd->model_data.aero_rep_int_indices == NULL) {
     printf("\n\nERROR allocating space for reaction integer indices\n\n");
     exit(EXIT_FAILURE);
   }
   sd->model_data.aero_rep_float_indices =
-      (int *)malloc((n_aero_rep + 1) * sizeof(int *));
+      (int *)arena_alloc(arena, (n_aero_rep + 1) * sizeof(int));
   if (sd->model_data.aero_rep_float_indices == NULL) {
     printf("\n\nERROR allocating space for reaction float indices\n\n");
     exit(EXIT_FAILURE);
   }
   sd->model_data.aero_rep_env_idx =
-      (int *)malloc((n_aero_rep + 1) * sizeof(int));
+      (int *)arena_alloc(arena, (n_aero_rep + 1) * sizeof(int));
   if (sd->model_data.aero_rep_env_idx == NULL) {
     printf(
         "\n\nERROR allocating space for aerosol representation "
@@ -295,45 +479,53 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
   sd->model_data.aero_rep_float_indices[0] = 0;
   sd->model_data.aero_rep_env_idx[0] = 0;
 
+  // The cached aerosol properties are set up during solver initialization
+  sd->model_data.n_aero_phase_inst = 0;
+  sd->model_data.aero_rep_phase_inst_idx = NULL;
+  sd->model_data.aero_phase_inst_num_jac_elem = NULL;
+  sd->model_data.aero_phase_inst_jac_idx = NULL;
+  sd->model_data.aero_phase_inst_conc_type = NULL;
+  sd->model_data.grid_cell_aero_eff_radius__m = NULL;
+  sd->model_data.grid_cell_aero_number_conc__n_m3 = NULL;
+  sd->model_data.grid_cell_aero_phase_mass__kg_m3 = NULL;
+  sd->model_data.grid_cell_aero_phase_avg_MW__kg_mol = NULL;
+  sd->model_data.grid_cell_aero_eff_radius_jac_elem = NULL;
+  sd->model_data.grid_cell_aero_number_conc_jac_elem = NULL;
+  sd->model_data.grid_cell_aero_phase_mass_jac_elem = NULL;
+  sd->model_data.grid_cell_aero_phase_avg_MW_jac_elem = NULL;
+
   // Allocate space for the sub model data and set the number of sub models
   // (including one int for the number of sub models and one int per sub
   // model to store the sub model type)
   sd->model_data.sub_model_int_data =
-      (int *)malloc((n_sub_model_int_param + n_sub_model) * sizeof(int));
+      (int *)arena_alloc(arena,
+                         (n_sub_model_int_param + n_sub_model) * sizeof(int));
   if (sd->model_data.sub_model_int_data == NULL) {
     printf("\n\nERROR allocating space for sub model integer data\n\n");
     exit(EXIT_FAILURE);
   }
   sd->model_data.sub_model_float_data =
-      (double *)malloc(n_sub_model_float_param * sizeof(double));
+      (double *)arena_alloc(arena, n_sub_model_float_param * sizeof(double));
   if (sd->model_data.sub_model_float_data == NULL) {
     printf("\n\nERROR allocating space for sub model floating-point data\n\n");
     exit(EXIT_FAILURE);
   }
-  sd->model_data.sub_model_env_data =
-      (double *)calloc(n_cells * n_sub_model_env_param, sizeof(double));
-  if (sd->model_data.sub_model_env_data == NULL) {
-    printf(
-        "\n\nERROR allocating space for sub model environment-dependent "
-        "data\n\n");
-    exit(EXIT_FAILURE);
-  }
 
   // Allocate space for the sub-model data pointers
   sd->model_data.sub_model_int_indices =
-      (int *)malloc((n_sub_model + 1) * sizeof(int *));
+      (int *)arena_alloc(arena, (n_sub_model + 1) * sizeof(int));
   if (sd->model_data.sub_model_int_indices == NULL) {
     printf("\n\nERROR allocating space for reaction integer indices\n\n");
     exit(EXIT_FAILURE);
   }
   sd->model_data.sub_model_float_indices =
-      (int *)malloc((n_sub_model + 1) * sizeof(int *));
+      (int *)arena_alloc(arena, (n_sub_model + 1) * sizeof(int));
   if (sd->model_data.sub_model_float_indices == NULL) {
     printf("\n\nERROR allocating space for reaction float indices\n\n");
     exit(EXIT_FAILURE);
   }
   sd->model_data.sub_model_env_idx =
-      (int *)malloc((n_sub_model + 1) * sizeof(int));
+      (int *)arena_alloc(arena, (n_sub_model + 1) * sizeof(int));
   if (sd->model_data.sub_model_env_idx == NULL) {
     printf(
         "\n\nERROR allocating space for sub model environment-dependent "
@@ -377,11 +569,7 @@ void solver_initialize(void *solver_data, double *abs_tol, double rel_tol,
   SolverData *sd;   // SolverData object
   int flag;         // return code from SUNDIALS functions
   int n_dep_var;    // number of dependent variables per grid cell
-  int i_dep_var;    // index of dependent variables in loops
-  int n_state_var;  // number of variables on the state array per
-                    // grid cell
   int n_cells;      // number of cells to solve simultaneously
-  int *var_type;    // state variable types
 
   // Seed the random number generator
   srand((unsigned int)100);
@@ -399,11 +587,9 @@ void solver_initialize(void *solver_data, double *abs_tol, double rel_tol,
   );
   check_flag_fail((void *)sd->cvode_mem, "CVodeCreate", 0);
 
-  // Get the number of total and dependent variables on the state array,
-  // and the type of each state variable. All values are per-grid-cell.
-  n_state_var = sd->model_data.n_per_cell_state_var;
+  // Get the number of dependent variables per grid cell and the number of
+  // grid cells
   n_dep_var = sd->model_data.n_per_cell_dep_var;
-  var_type = sd->model_data.var_type;
   n_cells = sd->model_data.n_cells;
 
   // Set the solver data
@@ -416,16 +602,6 @@ void solver_initialize(void *solver_data, double *abs_tol, double rel_tol,
   flag = CVodeInit(sd->cvode_mem, f, (realtype)0.0, sd->y);
   check_flag_fail(&flag, "CVodeInit", 1);
 
-  // Set the relative and absolute tolerances
-  sd->abs_tol_nv = N_VNew_Serial(n_dep_var * n_cells);
-  i_dep_var = 0;
-  for (int i_cell = 0; i_cell < n_cells; ++i_cell)
-    for (int i_spec = 0; i_spec < n_state_var; ++i_spec)
-      if (var_type[i_spec] == CHEM_SPEC_VARIABLE)
-        NV_Ith_S(sd->abs_tol_nv, i_dep_var++) = (realtype)abs_tol[i_spec];
-  flag = CVodeSVtolerances(sd->cvode_mem, (realtype)rel_tol, sd->abs_tol_nv);
-  check_flag_fail(&flag, "CVodeSVtolerances", 1);
-
   // Add a pointer in the model data to the absolute tolerances for use during
   // solving. TODO find a better way to do this
   sd->model_data.abs_tol = abs_tol;
@@ -446,20 +622,29 @@ void solver_initialize(void *solver_data, double *abs_tol, double rel_tol,
   flag = CVodeSetMaxHnilWarns(sd->cvode_mem, MAX_TIMESTEP_WARNINGS);
   check_flag_fail(&flag, "CVodeSetMaxHnilWarns", 1);
 
-  // Get the structure of the Jacobian matrix
+  // Get the structure of the Jacobian matrix (this also sets the order of
+  // the solver variables)
   sd->J = get_jac_init(sd);
-  sd->model_data.J_init = SUNMatClone(sd->J);
-  SUNMatCopy(sd->J, sd->model_data.J_init);
 
-  // Create a Jacobian matrix for correcting negative predicted concentrations
-  // during solving
-  sd->J_guess = SUNMatClone(sd->J);
-  SUNMatCopy(sd->J, sd->J_guess);
+  // Set the relative and absolute tolerances
+  sd->abs_tol_nv = N_VNew_Serial(n_dep_var * n_cells);
+  for (int i_cell = 0; i_cell < n_cells; ++i_cell)
+    for (int i_dep = 0; i_dep < n_dep_var; ++i_dep)
+      NV_Ith_S(sd->abs_tol_nv, i_cell * n_dep_var + i_dep) =
+          (realtype)abs_tol[sd->model_data.dep_var_ids[i_dep]];
+  flag = CVodeSVtolerances(sd->cvode_mem, (realtype)rel_tol, sd->abs_tol_nv);
+  check_flag_fail(&flag, "CVodeSVtolerances", 1);
+
+  // Tabulate the rate constants, if requested
+  rxn_build_rate_table(&(sd->model_data));
 
   // Create a KLU SUNLinearSolver
   sd->ls = SUNKLU(sd->y, sd->J);
   check_flag_fail((void *)sd->ls, "SUNKLU", 0);
 
+  // Time the linear solver setup and solve calls
+  solver_time_linear_solver(sd);
+
   // Attach the linear solver and Jacobian to the CVodeMem object
   flag = CVDlsSetLinearSolver(sd->cvode_mem, sd->ls, sd->J);
   check_flag_fail(&flag, "CVDlsSetLinearSolver", 1);
@@ -470,7 +655,7 @@ void solver_initialize(void *solver_data, double *abs_tol, double rel_tol,
 
 #ifdef CAMP_CUSTOM_CVODE
   // Set a function to improve guesses for y sent to the linear solver
-  flag = CVodeSetDlsGuessHelper(sd->cvode_mem, guess_helper);
+  flag = CVodeSetDlsGuessHelper(sd->cvode_mem, timed_guess_helper);
   check_flag_fail(&flag, "CVodeSetDlsGuessHelper", 1);
 #endif
 
@@ -531,6 +716,53 @@ int solver_set_eval_jac(void *solver_data, bool eval_Jac) {
 }
 #endif
 
+/** \brief Request a rate constant lookup table
+ *
+ * Rate constants of temperature- and pressure-dependent gas-phase reactions
+ * are tabulated on an evenly spaced grid of temperatures and log pressures
+ * when the solver is initialized and interpolated during solving instead of
+ * being recalculated for every grid cell. Reactions whose interpolation error
+ * exceeds the tolerance, and grid cells outside of the tabulated range, use
+ * the analytic rate constants. Must be called before \c solver_initialize().
+ *
+ * \param solver_data A pointer to the solver data
+ * \param n_temp Number of temperature nodes (at least 2)
+ * \param temp_min__K Lowest tabulated temperature (K)
+ * \param temp_max__K Highest tabulated temperature (K)
+ * \param n_press Number of pressure nodes (at least 2)
+ * \param press_min__Pa Lowest tabulated pressure (Pa)
+ * \param press_max__Pa Highest tabulated pressure (Pa)
+ * \param tolerance Maximum relative interpolation error for a reaction to
+ *                  use tabulated rate constants
+ */
+int solver_set_rate_table(void *solver_data, int n_temp, double temp_min__K,
+                          double temp_max__K, int n_press,
+                          double press_min__Pa, double press_max__Pa,
+                          double tolerance) {
+  SolverData *sd = (SolverData *)solver_data;
+  RateTable *table = &(sd->model_data.rate_table);
+
+  if (n_temp < 2 || n_press < 2 || !(temp_min__K > 0.0) ||
+      !(temp_max__K > temp_min__K) || !(press_min__Pa > 0.0) ||
+      !(press_max__Pa > press_min__Pa) || !(tolerance > 0.0)) {
+    printf(
+        "\n\nERROR Invalid rate constant table: %d temperatures "
+        "[%le, %le] K, %d pressures [%le, %le] Pa, tolerance %le\n\n",
+        n_temp, temp_min__K, temp_max__K, n_press, press_min__Pa,
+        press_max__Pa, tolerance);
+    exit(EXIT_FAILURE);
+  }
+
+  table->n_temp = n_temp;
+  table->temp_min__K = temp_min__K;
+  table->temp_max__K = temp_max__K;
+  table->n_press = n_press;
+  table->log_press_min = log(press_min__Pa);
+  table->log_press_max = log(press_max__Pa);
+  table->tolerance = tolerance;
+  return CAMP_SOLVER_SUCCESS;
+}
+
 /** \brief Solve for a given timestep
  *
  * \param solver_data A pointer to the initialized solver data
@@ -546,29 +778,11 @@ int solver_run(void *solver_data, double *state, double *env, double t_initial,
 #ifdef CAMP_USE_SUNDIALS
   SolverData *sd = (SolverData *)solver_data;
   ModelData *md = &(sd->model_data);
-  int n_state_var = sd->model_data.n_per_cell_state_var;
-  int n_cells = sd->model_data.n_cells;
   int flag;
+  double run_start__s = solver_timer_now();
 
-  // Update the dependent variables
-  int i_dep_var = 0;
-  for (int i_cell = 0; i_cell < n_cells; i_cell++)
-    for (int i_spec = 0; i_spec < n_state_var; i_spec++)
-      if (sd->model_data.var_type[i_spec] == CHEM_SPEC_VARIABLE) {
-        NV_Ith_S(sd->y, i_dep_var++) =
-            state[i_spec + i_cell * n_state_var] > TINY
-                ? (realtype)state[i_spec + i_cell * n_state_var]
-                : TINY;
-      } else if (md->var_type[i_spec] == CHEM_SPEC_CONSTANT) {
-        state[i_spec + i_cell * n_state_var] =
-            state[i_spec + i_cell * n_state_var] > TINY
-                ? state[i_spec + i_cell * n_state_var]
-                : TINY;
-      }
-
-  // Update model data pointers
-  sd->model_data.total_state = state;
-  sd->model_data.total_env = env;
+  // Update the dependent variables and model data pointers
+  solver_set_state(sd, state, env);
 
 #ifdef CAMP_DEBUG
   // Update the debug output flag in CVODES and the linear solver
@@ -581,28 +795,15 @@ int solver_run(void *solver_data, double *state, double *env, double t_initial,
   // Reset the counter of Jacobian evaluation failures
   sd->Jac_eval_fails = 0;
 
+  // Reset the per-cell statistics
+  cell_stats_reset(sd);
+
   // Update data for new environmental state
   // (This is set up to assume the environmental variables do not change during
   //  solving. This can be changed in the future if necessary.)
-  for (int i_cell = 0; i_cell < md->n_cells; ++i_cell) {
-    // Set the grid cell state pointers
-    md->grid_cell_id = i_cell;
-    md->grid_cell_state = &(md->total_state[i_cell * md->n_per_cell_state_var]);
-    md->grid_cell_env = &(md->total_env[i_cell * CAMP_NUM_ENV_PARAM_]);
-    md->grid_cell_rxn_env_data =
-        &(md->rxn_env_data[i_cell * md->n_rxn_env_data]);
-    md->grid_cell_aero_rep_env_data =
-        &(md->aero_rep_env_data[i_cell * md->n_aero_rep_env_data]);
-    md->grid_cell_sub_model_env_data =
-        &(md->sub_model_env_data[i_cell * md->n_sub_model_env_data]);
+  solver_update_env_state(sd);
 
-    // Update the model for the current environmental state
-    aero_rep_update_env_state(md);
-    sub_model_update_env_state(md);
-    rxn_update_env_state(md);
-  }
-
-  CAMP_DEBUG_JAC_STRUCT(sd->model_data.J_init, "Begin solving");
+  CAMP_DEBUG_JAC_STRUCT(sd->J, "Begin solving");
 
   // Reset the flag indicating a current J_guess
   sd->curr_J_guess = false;
@@ -611,17 +812,25 @@ int solver_run(void *solver_data, double *state, double *env, double t_initial,
   sd->init_time_step = (t_final - t_initial) * DEFAULT_TIME_STEP;
 
   // Check whether there is anything to solve (filters empty air masses with no
-  // emissions)
-  if (is_anything_going_on_here(sd, t_initial, t_final) == false)
+  // emissions, and updates quiescent grid cells explicitly)
+  if (is_anything_going_on_here(sd, t_initial, t_final) == false) {
+    if (sd->n_explicit_cells > 0) {
+      solver_get_state(sd, state);
+      sub_model_calculate(md);
+    }
+    solver_trace_add(&(sd->trace), SOLVER_TRACE_SOLVER_RUN, run_start__s,
+                     solver_timer_now());
     return CAMP_SOLVER_SUCCESS;
+  }
 
   // Reinitialize the solver
   flag = CVodeReInit(sd->cvode_mem, t_initial, sd->y);
   check_flag_fail(&flag, "CVodeReInit", 1);
 
-  // Reinitialize the linear solver
-  flag = SUNKLUReInit(sd->ls, sd->J, SM_NNZ_S(sd->J), SUNKLU_REINIT_PARTIAL);
-  check_flag_fail(&flag, "SUNKLUReInit", 1);
+  // The Jacobian sparsity pattern does not change between calls, so the
+  // KLU symbolic analysis and the numeric factorization storage are reused
+  // (the linear solver setup falls back to a new factorization if the
+  // pivot order of the last factorization fails for the new state)
 
   // Set the inital time step
   flag = CVodeSetInitStep(sd->cvode_mem, sd->init_time_step);
@@ -632,6 +841,7 @@ int solver_run(void *solver_data, double *state, double *env, double t_initial,
   if (!sd->no_solve) {
     flag = CVode(sd->cvode_mem, (realtype)t_final, sd->y, &t_rt, CV_NORMAL);
     sd->solver_flag = flag;
+    cell_stats_set_err_norm(sd);
 #ifndef FAILURE_DETAIL
     if (flag < 0) {
 #else
@@ -649,49 +859,97 @@ int solver_run(void *solver_data, double *state, double *env, double t_initial,
         printf("\n Cell: %d ", i_cell);
         printf("temp = %le pressure = %le\n", env[i_cell * CAMP_NUM_ENV_PARAM_],
                env[i_cell * CAMP_NUM_ENV_PARAM_ + 1]);
-        for (int i_spec = 0, i_dep_var = 0; i_spec < md->n_per_cell_state_var;
-             i_spec++)
-          if (md->var_type[i_spec] == CHEM_SPEC_VARIABLE) {
-            printf(
-                "spec %d = %le deriv = %le\n", i_spec,
-                NV_Ith_S(sd->y, i_cell * md->n_per_cell_dep_var + i_dep_var),
-                NV_Ith_S(deriv, i_cell * md->n_per_cell_dep_var + i_dep_var));
-            i_dep_var++;
-          } else {
+        for (int i_dep_var = 0; i_dep_var < md->n_per_cell_dep_var;
+             i_dep_var++)
+          printf("spec %d = %le deriv = %le\n", md->dep_var_ids[i_dep_var],
+                 NV_Ith_S(sd->y, i_cell * md->n_per_cell_dep_var + i_dep_var),
+                 NV_Ith_S(deriv, i_cell * md->n_per_cell_dep_var + i_dep_var));
+        for (int i_spec = 0; i_spec < md->n_per_cell_state_var; i_spec++)
+          if (md->var_type[i_spec] != CHEM_SPEC_VARIABLE)
             printf("spec %d = %le\n", i_spec,
                    state[i_cell * md->n_per_cell_state_var + i_spec]);
-          }
       }
       solver_print_stats(sd->cvode_mem);
 #endif
+      solver_trace_add(&(sd->trace), SOLVER_TRACE_SOLVER_RUN, run_start__s,
+                       solver_timer_now());
       return CAMP_SOLVER_FAIL;
     }
   }
 
   // Update the species concentrations on the state array
-  i_dep_var = 0;
-  for (int i_cell = 0; i_cell < n_cells; i_cell++) {
-    for (int i_spec = 0; i_spec < n_state_var; i_spec++) {
-      if (md->var_type[i_spec] == CHEM_SPEC_VARIABLE) {
-        state[i_spec + i_cell * n_state_var] =
-            (double)(NV_Ith_S(sd->y, i_dep_var) > 0.0
-                         ? NV_Ith_S(sd->y, i_dep_var)
-                         : 0.0);
-        i_dep_var++;
-      }
-    }
-  }
+  solver_get_state(sd, state);
 
   // Re-run the pre-derivative calculations to update equilibrium species
   // and apply adjustments to final state
   sub_model_calculate(md);
 
+  solver_trace_add(&(sd->trace), SOLVER_TRACE_SOLVER_RUN, run_start__s,
+                   solver_timer_now());
   return CAMP_SOLVER_SUCCESS;
 #else
   return CAMP_SOLVER_FAIL;
 #endif
 }
 
+/** \brief Time the derivative and Jacobian calculations for a model state
+ *
+ * The environmental state update, \c f() and \c Jac() are each called
+ * \c n_repeat times for the given state, without integrating. Timings are
+ * indexed by \c SolverBenchmarkKernel. The Jacobian saved for use in the
+ * derivative estimate is updated, as it would be during solving.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param state Pointer to the state array
+ * \param env Pointer to the environmental state array
+ * \param n_repeat Number of times to call each kernel
+ * \param mean_time__s Mean time per call for each kernel [s]
+ * \param min_time__s Minimum time per call for each kernel [s]
+ * \return CAMP_SOLVER_SUCCESS or CAMP_SOLVER_FAIL (if a kernel call fails)
+ */
+int solver_benchmark(void *solver_data, double *state, double *env,
+                     int n_repeat, double *mean_time__s, double *min_time__s) {
+#ifdef CAMP_USE_SUNDIALS
+  SolverData *sd = (SolverData *)solver_data;
+  int status = CAMP_SOLVER_SUCCESS;
+
+  solver_set_state(sd, state, env);
+  sd->init_time_step = DEFAULT_TIME_STEP;
+  for (int i_kernel = 0; i_kernel < SOLVER_BENCH_NUM_KERNELS; ++i_kernel) {
+    mean_time__s[i_kernel] = 0.0;
+    min_time__s[i_kernel] = 0.0;
+    for (int i_repeat = 0; i_repeat < n_repeat; ++i_repeat) {
+      int flag = 0;
+      double start__s = solver_timer_now();
+      switch (i_kernel) {
+        case SOLVER_BENCH_UPDATE_ENV_STATE:
+          for (int i_cell = 0; i_cell < sd->model_data.n_cells; ++i_cell)
+            sd->model_data.env_cache[i_cell * sd->model_data.n_env_cache] =
+                NAN;
+          solver_update_env_state(sd);
+          break;
+        case SOLVER_BENCH_DERIV:
+          flag = f(0.0, sd->y, sd->deriv, sd);
+          break;
+        case SOLVER_BENCH_JAC:
+          flag = Jac(0.0, sd->y, sd->deriv, sd->J, sd, sd->jac_tmp1, sd->y,
+                     sd->jac_tmp2);
+          break;
+      }
+      double time__s = solver_timer_now() - start__s;
+      if (flag != 0) status = CAMP_SOLVER_FAIL;
+      mean_time__s[i_kernel] += time__s / n_repeat;
+      if (i_repeat == 0 || time__s < min_time__s[i_kernel])
+        min_time__s[i_kernel] = time__s;
+    }
+  }
+
+  return status;
+#else
+  return CAMP_SOLVER_FAIL;
+#endif
+}
+
 /** \brief Get solver statistics after an integration attempt
  *
  * \param solver_data           Pointer to the solver data
@@ -774,23 +1032,797 @@ void solver_get_statistics(void *solver_data, int *solver_flag, int *num_steps,
   if (check_flag(&flag, "CVodeGetCurrentStep", 1) == CAMP_SOLVER_FAIL) return;
   *next_time_step__s = (double)curr_h;
   *Jac_eval_fails = sd->Jac_eval_fails;
+  *RHS_evals_total = (int)sd->timers.calls[SOLVER_TIMER_DERIV];
+  *Jac_evals_total = (int)sd->timers.calls[SOLVER_TIMER_JAC];
+  *RHS_time__s = sd->timers.time__s[SOLVER_TIMER_DERIV];
+  *Jac_time__s = sd->timers.time__s[SOLVER_TIMER_JAC];
 #ifdef CAMP_DEBUG
-  *RHS_evals_total = sd->counterDeriv;
-  *Jac_evals_total = sd->counterJac;
-  *RHS_time__s = ((double)sd->timeDeriv) / CLOCKS_PER_SEC;
-  *Jac_time__s = ((double)sd->timeJac) / CLOCKS_PER_SEC;
   *max_loss_precision = sd->max_loss_precision;
 #else
-  *RHS_evals_total = -1;
-  *Jac_evals_total = -1;
-  *RHS_time__s = 0.0;
-  *Jac_time__s = 0.0;
   *max_loss_precision = 0.0;
 #endif
 #endif
 }
 
 #ifdef CAMP_USE_SUNDIALS
+/** \brief Decompose the solver variables into blocks of coupled species
+ *
+ * The decomposition is built from the solver Jacobian sparsity pattern of
+ * one grid cell, so species are indexed by their solver variable ids.
+ *
+ * \param sd Pointer to the SolverData object
+ * \return Flag indicating whether the decomposition was successful
+ *         (0 = false; 1 = true)
+ */
+static int solver_subsystems_initialize(SolverData *sd) {
+  ModelData *md = &(sd->model_data);
+  unsigned int n_dep_var = (unsigned int)md->n_per_cell_dep_var;
+  Jacobian jac;
+
+  if (jacobian_initialize_empty(&jac, n_dep_var) != 1) return 0;
+  for (unsigned int i_col = 0; i_col < n_dep_var; ++i_col)
+    for (int i_elem = md->jac_cell_col_ptrs[i_col];
+         i_elem < md->jac_cell_col_ptrs[i_col + 1]; ++i_elem)
+      jacobian_register_element(
+          &jac, (unsigned int)md->jac_cell_row_ids[i_elem], i_col);
+  int success = jacobian_build_matrix(&jac) == 1 &&
+                subsystems_initialize(&(sd->subsystems), jac, NULL) == 1;
+  jacobian_free(&jac);
+#ifdef CAMP_DEBUG
+  if (success && sd->debug_out) subsystems_print(sd->subsystems);
+#endif
+  return success;
+}
+#endif
+
+/** \brief Get a summary of the mechanism subsystem decomposition
+ *
+ * The solver variables are split into blocks of species that are coupled to
+ * each other. Blocks in different independent groups do not interact, and
+ * blocks within a group are only coupled one way in block order. The
+ * decomposition is only an analysis of the mechanism (the solver does not
+ * use it), so it is done on the first call instead of during solver
+ * initialization.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param num_blocks Number of coupled blocks
+ * \param num_groups Number of independent groups of blocks
+ * \param largest_block Number of species in the largest block
+ */
+void solver_get_subsystem_info(void *solver_data, int *num_blocks,
+                               int *num_groups, int *largest_block) {
+#ifdef CAMP_USE_SUNDIALS
+  SolverData *sd = (SolverData *)solver_data;
+
+  if (sd->subsystems.block_ptrs == NULL && !solver_subsystems_initialize(sd)) {
+    printf("\n\nERROR decomposing the mechanism into subsystems\n\n");
+    exit(EXIT_FAILURE);
+  }
+  *num_blocks = (int)sd->subsystems.num_blocks;
+  *num_groups = (int)sd->subsystems.num_groups;
+  *largest_block = (int)subsystems_largest_block_size(sd->subsystems);
+#else
+  *num_blocks = 0;
+  *num_groups = 0;
+  *largest_block = 0;
+#endif
+}
+
+/** \brief Get information about the rate constant lookup table
+ *
+ * \param solver_data A pointer to the solver data
+ * \param num_rxn Number of reactions with tabulated rate constants
+ * \param max_rel_error Largest relative interpolation error of the tabulated
+ *                      reactions found during initialization
+ */
+void solver_get_rate_table_info(void *solver_data, int *num_rxn,
+                                double *max_rel_error) {
+  SolverData *sd = (SolverData *)solver_data;
+
+  *num_rxn = sd->model_data.rate_table.n_rxn;
+  *max_rel_error = sd->model_data.rate_table.max_rel_error;
+}
+
+/** \brief Set the tolerance for explicit updates of quiescent grid cells
+ *
+ * A grid cell is quiescent when, for every solver variable, the change over
+ * the time step estimated from the initial derivative is smaller than
+ * \c tolerance times the integration tolerance of the variable
+ * (<tt>abs_tol + rel_tol * |y|</tt>). Quiescent grid cells are updated with
+ * one explicit Euler step and are left out of the integration.
+ *
+ * \param solver_data A pointer to the solver data
+ * \param tolerance Fraction of the integration tolerances (0 = integrate all
+ *                  grid cells that are not empty)
+ * \return CAMP_SOLVER_SUCCESS
+ */
+int solver_set_quiescence(void *solver_data, double tolerance) {
+#ifdef CAMP_USE_SUNDIALS
+  SolverData *sd = (SolverData *)solver_data;
+
+  if (!(tolerance >= 0.0) || !(tolerance < 1.0)) {
+    printf("\n\nERROR Invalid quiescence tolerance: %le\n\n", tolerance);
+    exit(EXIT_FAILURE);
+  }
+  sd->quiescence_tol = tolerance;
+#endif
+  return CAMP_SOLVER_SUCCESS;
+}
+
+/** \brief Get the time spent in each phase of solving
+ *
+ * Phase times are inclusive, so phases that call other phases (e.g., the
+ * derivative calculation called during Jacobian evaluation) include the time
+ * spent in the phases they call. Phases are indexed by \c SolverTimerId.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param phase_time__s Time spent in each phase since the timers were last
+ *                      reset [s] (\c SOLVER_NUM_TIMERS elements)
+ * \param phase_calls Number of calls to each phase since the timers were last
+ *                    reset (\c SOLVER_NUM_TIMERS elements)
+ */
+void solver_get_timers(void *solver_data, double *phase_time__s,
+                       int *phase_calls) {
+#ifdef CAMP_USE_SUNDIALS
+  SolverData *sd = (SolverData *)solver_data;
+
+  for (int i_timer = 0; i_timer < SOLVER_NUM_TIMERS; ++i_timer) {
+    phase_time__s[i_timer] = sd->timers.time__s[i_timer];
+    phase_calls[i_timer] = (int)sd->timers.calls[i_timer];
+  }
+#else
+  for (int i_timer = 0; i_timer < SOLVER_NUM_TIMERS; ++i_timer) {
+    phase_time__s[i_timer] = 0.0;
+    phase_calls[i_timer] = 0;
+  }
+#endif
+}
+
+/** \brief Set the reaction and sub-model cost profiling level
+ *
+ * Setting the level resets the accumulated profile.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param level Profiling level (\c COST_PROFILE_OFF, \c COST_PROFILE_BY_TYPE
+ *              or \c COST_PROFILE_BY_RXN)
+ * \return CAMP_SOLVER_SUCCESS or CAMP_SOLVER_FAIL
+ */
+int solver_set_cost_profile(void *solver_data, int level) {
+  SolverData *sd = (SolverData *)solver_data;
+
+  if (!cost_profile_set_level(&(sd->model_data.cost_profile), level))
+    return CAMP_SOLVER_FAIL;
+  return CAMP_SOLVER_SUCCESS;
+}
+
+/** \brief Turn the per-cell solver phase timers on or off
+ *
+ * The aerosol representation, sub-model, reaction and Jacobian assembly
+ * phases, and the grid cell times, are timed for every grid cell in each
+ * call to f() and Jac(). They are on by default and can be turned off to
+ * avoid reading the clock for every grid cell. Calls to f() and Jac(), the
+ * environmental state update, the linear solver and the guess helper are
+ * always timed.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param phase_timing Flag indicating whether to time the per-cell phases
+ *                     (0 = false; otherwise true)
+ * \return CAMP_SOLVER_SUCCESS
+ */
+int solver_set_phase_timing(void *solver_data, int phase_timing) {
+  SolverData *sd = (SolverData *)solver_data;
+
+  sd->phase_timing = phase_timing != 0;
+  return CAMP_SOLVER_SUCCESS;
+}
+
+/** \brief Start recording a timeline of solver events
+ *
+ * The events are written to the trace file in Chrome-trace JSON format when
+ * the solver is freed. Any events already recorded are first written to the
+ * previous trace file.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param file_name Trace file name
+ * \param process_id Process id for the timeline (e.g., MPI rank)
+ * \param thread_id Thread id for the timeline
+ * \param max_events Maximum number of events to keep (older events are
+ *                   dropped; if <= 0, a default size is used)
+ * \return CAMP_SOLVER_SUCCESS or CAMP_SOLVER_FAIL
+ */
+int solver_start_trace(void *solver_data, char *file_name, int process_id,
+                       int thread_id, int max_events) {
+  SolverData *sd = (SolverData *)solver_data;
+
+  if (!solver_trace_start(&(sd->trace), file_name, process_id, thread_id,
+                          (long int)max_events))
+    return CAMP_SOLVER_FAIL;
+  return CAMP_SOLVER_SUCCESS;
+}
+
+/** \brief Start counting hardware events in the solver
+ *
+ * Cycles, instructions, cache misses and branch misses are counted for the
+ * calling thread in f(), Jac() and the linear solver setup and solve, and
+ * are reset along with the solver timers. This must be called from the
+ * thread that runs the solver.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \return CAMP_SOLVER_SUCCESS or CAMP_SOLVER_FAIL (e.g., if the counters are
+ *         not available on this system)
+ */
+int solver_start_hw_counters(void *solver_data) {
+  SolverData *sd = (SolverData *)solver_data;
+
+  if (!hw_counters_start(&(sd->hw_counters))) return CAMP_SOLVER_FAIL;
+  return CAMP_SOLVER_SUCCESS;
+}
+
+/** \brief Get the hardware event counts since the timers were last reset
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param counts Event counts for each region (\c HwRegionId) and counter
+ *               (\c HwCounterId), with the counter varying fastest
+ *               (\c HW_NUM_REGIONS * \c HW_NUM_COUNTERS elements)
+ * \param calls Number of times each region was counted (\c HW_NUM_REGIONS
+ *              elements)
+ */
+void solver_get_hw_counters(void *solver_data, long long *counts,
+                            int *calls) {
+  SolverData *sd = (SolverData *)solver_data;
+
+  for (int i_count = 0; i_count < HW_NUM_REGIONS * HW_NUM_COUNTERS; ++i_count)
+    counts[i_count] = sd->hw_counters.counts[i_count];
+  for (int i_region = 0; i_region < HW_NUM_REGIONS; ++i_region)
+    calls[i_region] = (int)sd->hw_counters.calls[i_region];
+}
+
+#ifdef CAMP_USE_SUNDIALS
+/** \brief Get the bytes allocated for a sparse matrix
+ *
+ * \param M Sparse matrix (may be NULL)
+ * \return Bytes used by the data, index and pointer arrays
+ */
+static long long sparse_matrix_bytes(SUNMatrix M) {
+  if (M == NULL) return 0;
+  return (long long)SM_NNZ_S(M) * (sizeof(realtype) + sizeof(sunindextype)) +
+         (long long)(SM_NP_S(M) + 1) * sizeof(sunindextype);
+}
+
+/** \brief Get the bytes allocated for a serial vector
+ *
+ * \param v Serial vector (may be NULL)
+ * \return Bytes used by the vector data
+ */
+static long long vector_bytes(N_Vector v) {
+  if (v == NULL) return 0;
+  return (long long)NV_LENGTH_S(v) * sizeof(realtype);
+}
+#endif
+
+/** \brief Get the memory used by an initialized solver
+ *
+ * Memory is reported in bytes for each \c MemCategoryId, split into a fixed
+ * part and a part per grid cell. Multi-cell arrays are counted per cell. The
+ * KLU factorizations and the CVODE workspace are only known as totals and
+ * are split evenly between the cells; the factorizations are only counted
+ * after the first call to solver_run(). Counts are for the arrays allocated
+ * by CAMP, SUNDIALS and KLU, and do not include allocator overhead.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param fixed_bytes Bytes independent of the number of cells
+ *                    (\c MEM_NUM_CATEGORIES elements)
+ * \param per_cell_bytes Bytes per grid cell (\c MEM_NUM_CATEGORIES elements)
+ */
+void solver_get_memory_report(void *solver_data, long long *fixed_bytes,
+                              long long *per_cell_bytes) {
+  SolverData *sd = (SolverData *)solver_data;
+  ModelData *md = &(sd->model_data);
+  int n_cells = md->n_cells;
+  MemoryReport report;
+  long long int_size = sizeof(int);
+  long long dbl_size = sizeof(double);
+
+  memory_report_reset(&report);
+
+  // Reaction data and the active reaction lists
+  memory_report_add(
+      &report, MEM_RXN_DATA,
+      md->rxn_int_indices[md->n_added_rxns] * int_size +
+          md->rxn_float_indices[md->n_added_rxns] * dbl_size +
+          3 * (md->n_rxn + 1) * int_size,
+      (md->n_rxn + 1) * int_size);
+  if (md->rxn_compact.rxn_offsets != NULL)
+    memory_report_add(&report, MEM_RXN_DATA,
+                      2 * (md->n_rxn + 1) * int_size +
+                          md->rxn_compact.n_ids * sizeof(unsigned short) +
+                          md->rxn_compact.n_yields * dbl_size,
+                      0);
+  if (md->rate_table.env_value_idx != NULL)
+    memory_report_add(&report, MEM_RXN_DATA,
+                      (md->n_rxn_env_data + 1) * int_size, 0);
+  if (md->rate_table.log_values != NULL)
+    memory_report_add(&report, MEM_RXN_DATA,
+                      ((long long)md->rate_table.n_temp *
+                           md->rate_table.n_press +
+                       1) * md->rate_table.n_values * dbl_size,
+                      0);
+
+  // Aerosol phase and representation data
+  memory_report_add(
+      &report, MEM_AERO_DATA,
+      md->aero_phase_int_indices[md->n_added_aero_phases] * int_size +
+          md->aero_phase_float_indices[md->n_added_aero_phases] * dbl_size +
+          2 * (md->n_aero_phase + 1) * int_size +
+          md->aero_rep_int_indices[md->n_added_aero_reps] * int_size +
+          md->aero_rep_float_indices[md->n_added_aero_reps] * dbl_size +
+          3 * (md->n_aero_rep + 1) * int_size,
+      0);
+  if (md->aero_phase_inst_jac_idx != NULL) {
+    long long n_inst = md->n_aero_phase_inst;
+    long long n_jac_elem = md->aero_phase_inst_jac_idx[n_inst];
+    memory_report_add(&report, MEM_AERO_DATA,
+                      (md->n_aero_rep + 1) * int_size +
+                          3 * (n_inst + 1) * int_size +
+                          4 * (n_inst + 1) * dbl_size +
+                          4 * (n_jac_elem + 1) * dbl_size,
+                      0);
+  }
+
+  // Sub-model data
+  memory_report_add(
+      &report, MEM_SUB_MODEL_DATA,
+      md->sub_model_int_indices[md->n_added_sub_models] * int_size +
+          md->sub_model_float_indices[md->n_added_sub_models] * dbl_size +
+          3 * (md->n_sub_model + 1) * int_size,
+      0);
+
+  // Environment-dependent parameters
+  memory_report_add(&report, MEM_ENV_DATA, 0, md->n_cell_env_data * dbl_size);
+
+  // Solver state
+  memory_report_add(&report, MEM_SOLVER_STATE,
+                    sizeof(SolverData) +
+                        (md->n_per_cell_state_var + md->n_per_cell_dep_var +
+                         md->n_per_cell_const_var) *
+                            int_size,
+                    0);
+
+  // Event trace
+  if (sd->trace.events != NULL)
+    memory_report_add(
+        &report, MEM_DIAGNOSTICS,
+        sd->trace.max_events * (long long)sizeof(SolverTraceEvent), 0);
+
+  // Reaction cost profile
+  if (md->cost_profile.rxn_time__s != NULL)
+    memory_report_add(&report, MEM_DIAGNOSTICS,
+                      (long long)md->cost_profile.n_rxn *
+                          COST_PROFILE_NUM_PHASES *
+                          (sizeof(double) + sizeof(long int)),
+                      0);
+
+#ifdef CAMP_USE_SUNDIALS
+  // Solver and working vectors
+  memory_report_add_scaled(
+      &report, MEM_SOLVER_STATE,
+      vector_bytes(sd->y) + vector_bytes(sd->deriv) +
+          vector_bytes(sd->abs_tol_nv) + vector_bytes(md->J_state) +
+          vector_bytes(md->J_deriv) + vector_bytes(md->J_tmp) +
+          vector_bytes(md->J_tmp2) + vector_bytes(sd->jac_tmp1) +
+          vector_bytes(sd->jac_tmp2),
+      n_cells);
+  memory_report_add(
+      &report, MEM_SOLVER_STATE,
+      2 * (long long)sd->time_deriv.num_spec * sizeof(long double), 0);
+
+  // Jacobian matrices, maps and structure
+  memory_report_add_scaled(&report, MEM_JACOBIAN, sparse_matrix_bytes(sd->J),
+                           n_cells);
+  memory_report_add(&report, MEM_JACOBIAN, 0,
+                    md->n_per_cell_solver_jac_elem * dbl_size);
+  memory_report_add(
+      &report, MEM_JACOBIAN,
+      sparse_matrix_bytes(md->J_rxn) + sparse_matrix_bytes(md->J_params) +
+          (md->n_per_cell_dep_var + 1 + md->n_per_cell_solver_jac_elem) *
+              int_size +
+          (md->n_mapped_values + md->n_mapped_params) *
+              (long long)sizeof(JacMap) +
+          (sd->jac.num_spec + 1) * (long long)sizeof(unsigned int) +
+          sd->jac.num_elem *
+              (long long)(sizeof(unsigned int) + 2 * sizeof(long double)),
+      0);
+  if (sd->subsystems.block_ptrs != NULL)
+    memory_report_add(&report, MEM_JACOBIAN,
+                      (sd->subsystems.num_spec + 1) *
+                          (long long)(4 * sizeof(unsigned int) + sizeof(int)),
+                      0);
+
+  // KLU factorizations
+  if (sd->ls != NULL)
+    memory_report_add_scaled(
+        &report, MEM_LINEAR_SOLVER,
+        (long long)((SUNLinearSolverContent_KLU)sd->ls->content)
+            ->common.memusage,
+        n_cells);
+
+  // CVODE integrator and linear solver interface workspaces
+  if (sd->cvode_mem != NULL) {
+    long int lenrw = 0, leniw = 0;
+    long int lenrw_ls = 0, leniw_ls = 0;
+    if (CVodeGetWorkSpace(sd->cvode_mem, &lenrw, &leniw) != CV_SUCCESS)
+      lenrw = leniw = 0;
+    if (CVDlsGetWorkSpace(sd->cvode_mem, &lenrw_ls, &leniw_ls) !=
+        CVDLS_SUCCESS)
+      lenrw_ls = leniw_ls = 0;
+    memory_report_add_scaled(
+        &report, MEM_INTEGRATOR,
+        (long long)(lenrw + lenrw_ls) * sizeof(realtype) +
+            (long long)(leniw + leniw_ls) * sizeof(long int),
+        n_cells);
+  }
+
+  // Per-cell statistics
+  memory_report_add(&report, MEM_DIAGNOSTICS, 0,
+                    sizeof(*sd->cell_stats.rhs_contribs) +
+                        sizeof(*sd->cell_stats.neg_conc_rejections) +
+                        sizeof(*sd->cell_stats.guess_helper_activations) +
+                        sizeof(*sd->cell_stats.time__s) +
+                        sizeof(*sd->cell_stats.err_norm) +
+                        sizeof(*sd->cell_stats.env_updates));
+#endif
+
+  for (int i_cat = 0; i_cat < MEM_NUM_CATEGORIES; ++i_cat) {
+    fixed_bytes[i_cat] = report.fixed_bytes[i_cat];
+    per_cell_bytes[i_cat] = report.per_cell_bytes[i_cat];
+  }
+}
+
+/** \brief Get the reaction and sub-model cost profile
+ *
+ * Type arrays are indexed by type id, with the profiled calculation
+ * (\c CostProfilePhase) varying fastest. Per-reaction values are set to zero
+ * unless the profiling level is \c COST_PROFILE_BY_RXN.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param rxn_type_time__s Time for each reaction type [s]
+ *                         (\c COST_PROFILE_MAX_RXN_TYPE x phases)
+ * \param rxn_type_calls Calls for each reaction type
+ * \param sub_model_type_time__s Time for each sub-model type [s]
+ *                               (\c COST_PROFILE_MAX_SUB_MODEL_TYPE x phases)
+ * \param sub_model_type_calls Calls for each sub-model type
+ * \param rxn_time__s Time for each reaction [s] (number of reactions x phases)
+ * \param rxn_calls Calls for each reaction
+ */
+void solver_get_cost_profile(void *solver_data, double *rxn_type_time__s,
+                             long int *rxn_type_calls,
+                             double *sub_model_type_time__s,
+                             long int *sub_model_type_calls,
+                             double *rxn_time__s, long int *rxn_calls) {
+  SolverData *sd = (SolverData *)solver_data;
+  CostProfile *profile = &(sd->model_data.cost_profile);
+
+  for (int i = 0; i < COST_PROFILE_MAX_RXN_TYPE * COST_PROFILE_NUM_PHASES;
+       ++i) {
+    rxn_type_time__s[i] = profile->rxn_type_time__s[i];
+    rxn_type_calls[i] = profile->rxn_type_calls[i];
+  }
+  for (int i = 0; i < COST_PROFILE_MAX_SUB_MODEL_TYPE * COST_PROFILE_NUM_PHASES;
+       ++i) {
+    sub_model_type_time__s[i] = profile->sub_model_type_time__s[i];
+    sub_model_type_calls[i] = profile->sub_model_type_calls[i];
+  }
+  for (int i = 0; i < profile->n_rxn * COST_PROFILE_NUM_PHASES; ++i) {
+    if (profile->level == COST_PROFILE_BY_RXN) {
+      rxn_time__s[i] = profile->rxn_time__s[i];
+      rxn_calls[i] = profile->rxn_calls[i];
+    } else {
+      rxn_time__s[i] = 0.0;
+      rxn_calls[i] = 0;
+    }
+  }
+}
+
+/** \brief Get the solver statistics for each grid cell from the last run
+ *
+ * Arrays must have one element per grid cell.
+ *
+ * \param solver_data Pointer to the SolverData object
+ * \param rhs_contribs Reaction derivative contributions calculated
+ * \param neg_conc_rejections State updates rejected because of negative
+ *                            concentrations in the cell
+ * \param guess_helper_activations Guess helper calls made because of
+ *                                 negative predicted concentrations in the
+ *                                 cell
+ * \param time__s Time spent on the cell in f() and Jac() [s]
+ * \param err_norm Weighted RMS norm of the local error estimate for the cell
+ *                 at the last step
+ * \param env_updates Environment-dependent data updates for the cell (0 when
+ *                    its environmental state was unchanged)
+ */
+void solver_get_cell_statistics(void *solver_data, int *rhs_contribs,
+                                int *neg_conc_rejections,
+                                int *guess_helper_activations, double *time__s,
+                                double *err_norm, int *env_updates) {
+  SolverData *sd = (SolverData *)solver_data;
+  int n_cells = sd->model_data.n_cells;
+
+  for (int i_cell = 0; i_cell < n_cells; ++i_cell) {
+#ifdef CAMP_USE_SUNDIALS
+    rhs_contribs[i_cell] = sd->cell_stats.rhs_contribs[i_cell];
+    neg_conc_rejections[i_cell] = sd->cell_stats.neg_conc_rejections[i_cell];
+    guess_helper_activations[i_cell] =
+        sd->cell_stats.guess_helper_activations[i_cell];
+    time__s[i_cell] = sd->cell_stats.time__s[i_cell];
+    err_norm[i_cell] = sd->cell_stats.err_norm[i_cell];
+    env_updates[i_cell] = sd->cell_stats.env_updates[i_cell];
+#else
+    rhs_contribs[i_cell] = 0;
+    neg_conc_rejections[i_cell] = 0;
+    guess_helper_activations[i_cell] = 0;
+    time__s[i_cell] = 0.0;
+    err_norm[i_cell] = 0.0;
+    env_updates[i_cell] = 0;
+#endif
+  }
+}
+
+#ifdef CAMP_USE_SUNDIALS
+/** \brief Set the solver dependent variables from the model state
+ *
+ * Concentrations below TINY are raised to TINY, and the model data pointers
+ * are set to the state and environmental arrays. Solver variables packed from
+ * a host array since the last call are kept.
+ *
+ * \param sd Pointer to the SolverData object
+ * \param state Pointer to the state array
+ * \param env Pointer to the environmental state array
+ */
+static void solver_set_state(SolverData *sd, double *state, double *env) {
+  ModelData *md = &(sd->model_data);
+  int n_state_var = md->n_per_cell_state_var;
+  int n_dep_var = md->n_per_cell_dep_var;
+  int n_const_var = md->n_per_cell_const_var;
+  int *dep_var_ids = md->dep_var_ids;
+  int *const_var_ids = md->const_var_ids;
+
+  HostStateMap *host_map = sd->host_map;
+
+  for (int i_cell = 0; i_cell < md->n_cells; i_cell++) {
+    double *cell_state = &(state[i_cell * n_state_var]);
+    realtype *cell_y = &(NV_DATA_S(sd->y)[i_cell * n_dep_var]);
+    if (host_map == NULL) {
+      for (int i_dep = 0; i_dep < n_dep_var; i_dep++) {
+        double conc = cell_state[dep_var_ids[i_dep]];
+        cell_y[i_dep] = conc > TINY ? (realtype)conc : TINY;
+      }
+    } else {
+      // Solver variables packed from a host array are copied to the state
+      // array and the rest are taken from it
+      for (int i_dep = 0; i_dep < host_map->n_dep_assign; i_dep++) {
+        int id = host_map->dep_ids[i_dep];
+        if (cell_y[id] < TINY) cell_y[id] = TINY;
+        cell_state[dep_var_ids[id]] = (double)cell_y[id];
+      }
+      for (int i_dep = 0; i_dep < host_map->n_unmapped_dep; i_dep++) {
+        int id = host_map->unmapped_dep_ids[i_dep];
+        double conc = cell_state[dep_var_ids[id]];
+        cell_y[id] = conc > TINY ? (realtype)conc : TINY;
+      }
+    }
+    for (int i_const = 0; i_const < n_const_var; i_const++) {
+      double conc = cell_state[const_var_ids[i_const]];
+      cell_state[const_var_ids[i_const]] = conc > TINY ? conc : TINY;
+    }
+  }
+
+  sd->host_map = NULL;
+  md->total_state = state;
+  md->total_env = env;
+
+  // All grid cells are integrated until they are found to be quiescent
+  for (int i_cell = 0; i_cell < md->n_cells; i_cell++)
+    sd->cell_active[i_cell] = 1;
+  sd->n_explicit_cells = 0;
+}
+
+/** \brief Update the species concentrations on the state array from the
+ *         solver dependent variables
+ *
+ * Negative concentrations are set to zero.
+ *
+ * \param sd Pointer to the SolverData object
+ * \param state Pointer to the state array
+ */
+static void solver_get_state(SolverData *sd, double *state) {
+  ModelData *md = &(sd->model_data);
+  int n_state_var = md->n_per_cell_state_var;
+  int n_dep_var = md->n_per_cell_dep_var;
+  int *dep_var_ids = md->dep_var_ids;
+
+  for (int i_cell = 0; i_cell < md->n_cells; i_cell++) {
+    realtype *cell_y = &(NV_DATA_S(sd->y)[i_cell * n_dep_var]);
+    double *cell_state = &(state[i_cell * n_state_var]);
+    for (int i_dep = 0; i_dep < n_dep_var; i_dep++)
+      cell_state[dep_var_ids[i_dep]] =
+          (double)(cell_y[i_dep] > 0.0 ? cell_y[i_dep] : 0.0);
+  }
+}
+
+/** \brief Update the model data for the current environmental state
+ *
+ * The environment-dependent data of a grid cell is only recalculated when its
+ * temperature, pressure or constant species concentrations have changed
+ * since its last update, or when its reaction, aerosol representation or
+ * sub-model data has been updated.
+ *
+ * \param sd Pointer to the SolverData object
+ */
+static void solver_update_env_state(SolverData *sd) {
+  ModelData *md = &(sd->model_data);
+  int n_const_var = md->n_per_cell_const_var;
+  int *const_var_ids = md->const_var_ids;
+
+  double start__s = solver_timer_now();
+  for (int i_cell = 0; i_cell < md->n_cells; ++i_cell) {
+    // Skip grid cells whose environmental state and constant species are
+    // unchanged since their last update
+    double *cache = &(md->env_cache[i_cell * md->n_env_cache]);
+    double *cell_env = &(md->total_env[i_cell * CAMP_NUM_ENV_PARAM_]);
+    double *cell_state = &(md->total_state[i_cell * md->n_per_cell_state_var]);
+    bool changed = false;
+    for (int i_env = 0; i_env < CAMP_NUM_ENV_PARAM_; ++i_env) {
+      changed = changed || !(cache[i_env] == cell_env[i_env]);
+      cache[i_env] = cell_env[i_env];
+    }
+    for (int i_const = 0; i_const < n_const_var; ++i_const) {
+      double conc = cell_state[const_var_ids[i_const]];
+      changed = changed || !(cache[CAMP_NUM_ENV_PARAM_ + i_const] == conc);
+      cache[CAMP_NUM_ENV_PARAM_ + i_const] = conc;
+    }
+    if (!changed) continue;
+    ++(sd->cell_stats.env_updates[i_cell]);
+
+    // Set the grid cell state pointers
+    md->grid_cell_id = i_cell;
+    md->grid_cell_state = cell_state;
+    md->grid_cell_env = cell_env;
+    md->grid_cell_rxn_env_data =
+        &(md->rxn_env_data[i_cell * md->n_cell_env_data]);
+    md->grid_cell_aero_rep_env_data =
+        &(md->aero_rep_env_data[i_cell * md->n_cell_env_data]);
+    md->grid_cell_sub_model_env_data =
+        &(md->sub_model_env_data[i_cell * md->n_cell_env_data]);
+
+    // Update the model for the current environmental state
+    aero_rep_update_env_state(md);
+    sub_model_update_env_state(md);
+    rxn_update_env_state(md);
+  }
+  solver_timers_add(&(sd->timers), SOLVER_TIMER_UPDATE_ENV_STATE, start__s);
+}
+
+/** \brief Reset the per-cell solver statistics
+ *
+ * \param sd Pointer to the SolverData object
+ */
+static void cell_stats_reset(SolverData *sd) {
+  for (int i_cell = 0; i_cell < sd->model_data.n_cells; ++i_cell) {
+    sd->cell_stats.rhs_contribs[i_cell] = 0;
+    sd->cell_stats.neg_conc_rejections[i_cell] = 0;
+    sd->cell_stats.guess_helper_activations[i_cell] = 0;
+    sd->cell_stats.time__s[i_cell] = 0.0;
+    sd->cell_stats.err_norm[i_cell] = 0.0;
+    sd->cell_stats.env_updates[i_cell] = 0;
+  }
+}
+
+/** \brief Increment a per-cell counter for cells with negative concentrations
+ *
+ * \param sd Pointer to the SolverData object
+ * \param y Solver state vector
+ * \param counter Per-cell counter to increment
+ */
+static void cell_stats_count_negative(SolverData *sd, N_Vector y,
+                                      int *counter) {
+  int n_dep_var = sd->model_data.n_per_cell_dep_var;
+  realtype *y_data = NV_DATA_S(y);
+
+  for (int i_cell = 0; i_cell < sd->model_data.n_cells; ++i_cell) {
+    for (int i_var = 0; i_var < n_dep_var; ++i_var) {
+      if (y_data[i_cell * n_dep_var + i_var] < -SMALL) {
+        ++counter[i_cell];
+        break;
+      }
+    }
+  }
+}
+
+/** \brief Set the per-cell norms of the local error estimate
+ *
+ * The weighted RMS norm of the last step's local error estimate is
+ * calculated for each cell, so cells that limit the step size can be
+ * identified. The Jacobian working vectors are used as temporary storage.
+ *
+ * \param sd Pointer to the SolverData object
+ */
+static void cell_stats_set_err_norm(SolverData *sd) {
+  ModelData *md = &(sd->model_data);
+  int n_dep_var = md->n_per_cell_dep_var;
+
+  if (n_dep_var == 0) return;
+  if (CVodeGetEstLocalErrors(sd->cvode_mem, md->J_tmp) != CV_SUCCESS ||
+      CVodeGetErrWeights(sd->cvode_mem, md->J_tmp2) != CV_SUCCESS)
+    return;
+  realtype *ele = NV_DATA_S(md->J_tmp);
+  realtype *ewt = NV_DATA_S(md->J_tmp2);
+  for (int i_cell = 0; i_cell < md->n_cells; ++i_cell) {
+    double sum = 0.0;
+    for (int i_var = i_cell * n_dep_var; i_var < (i_cell + 1) * n_dep_var;
+         ++i_var)
+      sum += (ele[i_var] * ewt[i_var]) * (ele[i_var] * ewt[i_var]);
+    sd->cell_stats.err_norm[i_cell] = sqrt(sum / n_dep_var);
+  }
+}
+
+/** \brief Set the multi-cell solver Jacobian sparsity pattern
+ *
+ * The pattern is built from the single-cell pattern shared by all grid cells
+ * and the values are set to zero.
+ *
+ * \param md Pointer to the model data
+ * \param J Solver Jacobian sized for all grid cells
+ */
+static void jac_set_pattern(ModelData *md, SUNMatrix J) {
+  int n_dep_var = md->n_per_cell_dep_var;
+  int n_elem = md->n_per_cell_solver_jac_elem;
+  int n_cells = md->n_cells;
+  sunindextype *col_ptrs = SM_INDEXPTRS_S(J);
+  sunindextype *row_ids = SM_INDEXVALS_S(J);
+  realtype *data = SM_DATA_S(J);
+
+  SM_NNZ_S(J) = n_cells * n_elem;
+  for (int i_cell = 0; i_cell < n_cells; ++i_cell) {
+    sunindextype var_offset = i_cell * n_dep_var;
+    sunindextype elem_offset = i_cell * n_elem;
+    for (int i_col = 0; i_col < n_dep_var; ++i_col)
+      col_ptrs[var_offset + i_col] =
+          md->jac_cell_col_ptrs[i_col] + elem_offset;
+    for (int i_elem = 0; i_elem < n_elem; ++i_elem) {
+      row_ids[elem_offset + i_elem] =
+          md->jac_cell_row_ids[i_elem] + var_offset;
+      data[elem_offset + i_elem] = (realtype)0.0;
+    }
+  }
+  col_ptrs[n_cells * n_dep_var] = n_cells * n_elem;
+}
+
+/** \brief Multiply the saved solver Jacobian by a vector
+ *
+ * Computes \f$y = J x\f$ using the saved Jacobian values and the single-cell
+ * sparsity pattern shared by all grid cells.
+ *
+ * \param md Pointer to the model data
+ * \param x Vector to multiply
+ * \param y Result vector
+ */
+static void jac_solver_matvec(ModelData *md, N_Vector x, N_Vector y) {
+  int n_dep_var = md->n_per_cell_dep_var;
+  int n_elem = md->n_per_cell_solver_jac_elem;
+  realtype *x_data = NV_DATA_S(x);
+  realtype *y_data = NV_DATA_S(y);
+
+  N_VConst(ZERO, y);
+  for (int i_cell = 0; i_cell < md->n_cells; ++i_cell) {
+    realtype *cell_x = &(x_data[i_cell * n_dep_var]);
+    realtype *cell_y = &(y_data[i_cell * n_dep_var]);
+    double *cell_J = &(md->J_solver_data[i_cell * n_elem]);
+    for (int i_col = 0; i_col < n_dep_var; ++i_col)
+      for (int i_elem = md->jac_cell_col_ptrs[i_col];
+           i_elem < md->jac_cell_col_ptrs[i_col + 1]; ++i_elem)
+        cell_y[md->jac_cell_row_ids[i_elem]] += cell_J[i_elem] * cell_x[i_col];
+  }
+}
 
 /** \brief Update the model state from the current solver state
  *
@@ -808,30 +1840,52 @@ int camp_solver_update_model_state(N_Vector solver_state, ModelData *model_data,
   int n_state_var = model_data->n_per_cell_state_var;
   int n_dep_var = model_data->n_per_cell_dep_var;
   int n_cells = model_data->n_cells;
+  int *dep_var_ids = model_data->dep_var_ids;
 
-  int i_dep_var = 0;
+  // Scatter the solver variables to the state array, replacing low
+  // concentrations, and count negative concentrations along the way so the
+  // loop has no early exit
+  int n_negative = 0;
   for (int i_cell = 0; i_cell < n_cells; i_cell++) {
-    for (int i_spec = 0; i_spec < n_state_var; ++i_spec) {
-      if (model_data->var_type[i_spec] == CHEM_SPEC_VARIABLE) {
-        if (NV_DATA_S(solver_state)[i_dep_var] < -SMALL) {
+    realtype *cell_y = &(NV_DATA_S(solver_state)[i_cell * n_dep_var]);
+    double *cell_state = &(model_data->total_state[i_cell * n_state_var]);
+    for (int i_dep = 0; i_dep < n_dep_var; i_dep++) {
+      realtype conc = cell_y[i_dep];
+      n_negative += conc < -SMALL;
+      cell_state[dep_var_ids[i_dep]] =
+          conc > threshhold ? conc : replacement_value;
+    }
+  }
+  if (n_negative > 0) {
 #ifdef FAILURE_DETAIL
-          printf("\nFailed model state update: [spec %d] = %le", i_spec,
-                 NV_DATA_S(solver_state)[i_dep_var]);
+    for (int i_var = 0; i_var < n_cells * n_dep_var; i_var++)
+      if (NV_DATA_S(solver_state)[i_var] < -SMALL)
+        printf("\nFailed model state update: [spec %d] = %le",
+               dep_var_ids[i_var % n_dep_var], NV_DATA_S(solver_state)[i_var]);
 #endif
-          return CAMP_SOLVER_FAIL;
-        }
-        // Assign model state to solver_state
-        model_data->total_state[i_spec + i_cell * n_state_var] =
-            NV_DATA_S(solver_state)[i_dep_var] > threshhold
-                ? NV_DATA_S(solver_state)[i_dep_var]
-                : replacement_value;
-        i_dep_var++;
-      }
-    }
+    return CAMP_SOLVER_FAIL;
   }
   return CAMP_SOLVER_SUCCESS;
 }
 
+/** \brief Add the time elapsed since a start time to a solver sub-phase timer
+ *
+ * Sub-phases (aerosol representation updates, sub-model calculations,
+ * reaction contributions and Jacobian assembly) are timed once per grid cell,
+ * so they can be turned off with \c solver_set_phase_timing(). Calls to f()
+ * and Jac() are always timed.
+ *
+ * \param sd Pointer to the solver data
+ * \param timer_id Timer to add the elapsed time to
+ * \param start__s Start time (s) from \c solver_timer_now()
+ * \return Current time (s), or \c start__s when phase timing is off
+ */
+static inline double phase_timer_add(SolverData *sd, SolverTimerId timer_id,
+                                     double start__s) {
+  if (!sd->phase_timing) return start__s;
+  return solver_timers_add(&(sd->timers), timer_id, start__s);
+}
+
 /** \brief Compute the time derivative f(t,y)
  *
  * \param t Current model time (s)
@@ -844,10 +1898,9 @@ int f(realtype t, N_Vector y, N_Vector deriv, void *solver_data) {
   SolverData *sd = (SolverData *)solver_data;
   ModelData *md = &(sd->model_data);
   realtype time_step;
-
-#ifdef CAMP_DEBUG
-  sd->counterDeriv++;
-#endif
+  double f_start__s = solver_timer_now();
+  HwCounterSample f_start_hw;
+  hw_counters_read(&(sd->hw_counters), &f_start_hw);
 
   // Get a pointer to the derivative data
   double *deriv_data = N_VGetArrayPointer(deriv);
@@ -860,6 +1913,9 @@ int f(realtype t, N_Vector y, N_Vector deriv, void *solver_data) {
   int n_state_var = md->n_per_cell_state_var;
   int n_dep_var = md->n_per_cell_dep_var;
 
+  // Sub-phase and per-cell times can be turned off
+  int phase_timing = sd->phase_timing;
+
   // Get the current integrator time step (s)
   CVodeGetCurrentStep(sd->cvode_mem, &time_step);
 
@@ -870,56 +1926,63 @@ int f(realtype t, N_Vector y, N_Vector deriv, void *solver_data) {
   // Update the state array with the current dependent variable values.
   // Signal a recoverable error (positive return value) for negative
   // concentrations.
-  if (camp_solver_update_model_state(y, md, -SMALL, TINY) != CAMP_SOLVER_SUCCESS)
+  if (camp_solver_update_model_state(y, md, -SMALL, TINY) !=
+      CAMP_SOLVER_SUCCESS) {
+    cell_stats_count_negative(sd, y, sd->cell_stats.neg_conc_rejections);
+    hw_counters_add(&(sd->hw_counters), HW_REGION_DERIV, &f_start_hw);
+    solver_trace_add(&(sd->trace), SOLVER_TRACE_DERIV, f_start__s,
+                     solver_timers_add(&(sd->timers), SOLVER_TIMER_DERIV,
+                                       f_start__s));
     return 1;
+  }
 
   // Get the Jacobian-estimated derivative
   N_VLinearSum(1.0, y, -1.0, md->J_state, md->J_tmp);
-  SUNMatMatvec(md->J_solver, md->J_tmp, md->J_tmp2);
+  jac_solver_matvec(md, md->J_tmp, md->J_tmp2);
   N_VLinearSum(1.0, md->J_deriv, 1.0, md->J_tmp2, md->J_tmp);
 
-#ifdef CAMP_DEBUG
-  // Measure calc_deriv time execution
-  clock_t start = clock();
-#endif
-
 #ifdef CAMP_USE_GPU
   // Reset the derivative vector
   N_VConst(ZERO, deriv);
 
   // Calculate the time derivative f(t,y)
   // (this is for all grid cells at once)
+  double gpu_start__s = phase_timing ? solver_timer_now() : 0.0;
   rxn_calc_deriv_gpu(md, deriv, (double)time_step);
-#endif
-
-#ifdef CAMP_DEBUG
-  clock_t end = clock();
-  sd->timeDeriv += (end - start);
+  phase_timer_add(sd, SOLVER_TIMER_RXN_DERIV, gpu_start__s);
 #endif
 
   // Loop through the grid cells and update the derivative array
   for (int i_cell = 0; i_cell < n_cells; ++i_cell) {
+    // Grid cells left out of the integration do not change
+    if (!sd->cell_active[i_cell]) {
+      for (int i_dep = 0; i_dep < n_dep_var; ++i_dep)
+        deriv_data[i_dep] = ZERO;
+      deriv_data += n_dep_var;
+      jac_deriv_data += n_dep_var;
+      continue;
+    }
+
     // Set the grid cell state pointers
     md->grid_cell_id = i_cell;
     md->grid_cell_state = &(md->total_state[i_cell * n_state_var]);
     md->grid_cell_env = &(md->total_env[i_cell * CAMP_NUM_ENV_PARAM_]);
     md->grid_cell_rxn_env_data =
-        &(md->rxn_env_data[i_cell * md->n_rxn_env_data]);
+        &(md->rxn_env_data[i_cell * md->n_cell_env_data]);
     md->grid_cell_aero_rep_env_data =
-        &(md->aero_rep_env_data[i_cell * md->n_aero_rep_env_data]);
+        &(md->aero_rep_env_data[i_cell * md->n_cell_env_data]);
     md->grid_cell_sub_model_env_data =
-        &(md->sub_model_env_data[i_cell * md->n_sub_model_env_data]);
+        &(md->sub_model_env_data[i_cell * md->n_cell_env_data]);
 
     // Update the aerosol representations
+    double cell_start__s = phase_timing ? solver_timer_now() : 0.0;
+    double start__s = cell_start__s;
     aero_rep_update_state(md);
+    start__s = phase_timer_add(sd, SOLVER_TIMER_AERO_REP_UPDATE, start__s);
 
     // Run the sub models
     sub_model_calculate(md);
-
-#ifdef CAMP_DEBUG
-    // Measure calc_deriv time execution
-    clock_t start2 = clock();
-#endif
+    start__s = phase_timer_add(sd, SOLVER_TIMER_SUB_MODEL_CALC, start__s);
 
 #ifndef CAMP_USE_GPU
     // Reset the TimeDerivative
@@ -942,9 +2005,12 @@ int f(realtype t, N_Vector y, N_Vector deriv, void *solver_data) {
     rxn_calc_deriv_specific_types(md, sd->time_deriv, (double)time_step);
 #endif
 
+    start__s = phase_timer_add(sd, SOLVER_TIMER_RXN_DERIV, start__s);
+    if (phase_timing)
+      sd->cell_stats.time__s[i_cell] += start__s - cell_start__s;
+    sd->cell_stats.rhs_contribs[i_cell] += md->n_active_rxn[i_cell];
+
 #ifdef CAMP_DEBUG
-    clock_t end2 = clock();
-    sd->timeDeriv += (end2 - start2);
     sd->max_loss_precision = time_derivative_max_loss_precision(sd->time_deriv);
 #endif
 
@@ -952,6 +2018,10 @@ int f(realtype t, N_Vector y, N_Vector deriv, void *solver_data) {
     deriv_data += n_dep_var;
     jac_deriv_data += n_dep_var;
   }
+  hw_counters_add(&(sd->hw_counters), HW_REGION_DERIV, &f_start_hw);
+  solver_trace_add(&(sd->trace), SOLVER_TRACE_DERIV, f_start__s,
+                   solver_timers_add(&(sd->timers), SOLVER_TIMER_DERIV,
+                                     f_start__s));
 
   // Return 0 if success
   return (0);
@@ -974,16 +2044,18 @@ int Jac(realtype t, N_Vector y, N_Vector deriv, SUNMatrix J, void *solver_data,
   SolverData *sd = (SolverData *)solver_data;
   ModelData *md = &(sd->model_data);
   realtype time_step;
-
-#ifdef CAMP_DEBUG
-  sd->counterJac++;
-#endif
+  double jac_start__s = solver_timer_now();
+  HwCounterSample jac_start_hw;
+  hw_counters_read(&(sd->hw_counters), &jac_start_hw);
 
   // Get the grid cell dimensions
   int n_state_var = md->n_per_cell_state_var;
   int n_dep_var = md->n_per_cell_dep_var;
   int n_cells = md->n_cells;
 
+  // Sub-phase and per-cell times can be turned off
+  int phase_timing = sd->phase_timing;
+
   // Get pointers to the rxn and parameter Jacobian arrays
   double *J_param_data = SM_DATA_S(md->J_params);
   double *J_rxn_data = SM_DATA_S(md->J_rxn);
@@ -1007,6 +2079,10 @@ int Jac(realtype t, N_Vector y, N_Vector deriv, SUNMatrix J, void *solver_data,
   if (f(t, y, deriv, solver_data) != 0) {
     printf("\n Derivative calculation failed.\n");
     sd->use_deriv_est = 1;
+    hw_counters_add(&(sd->hw_counters), HW_REGION_JAC, &jac_start_hw);
+    solver_trace_add(&(sd->trace), SOLVER_TRACE_JAC, jac_start__s,
+                     solver_timers_add(&(sd->timers), SOLVER_TIMER_JAC,
+                                       jac_start__s));
     return 1;
   }
   sd->use_deriv_est = 1;
@@ -1014,69 +2090,69 @@ int Jac(realtype t, N_Vector y, N_Vector deriv, SUNMatrix J, void *solver_data,
   // Update the state array with the current dependent variable values
   // Signal a recoverable error (positive return value) for negative
   // concentrations.
-  if (camp_solver_update_model_state(y, md, -SMALL, TINY) != CAMP_SOLVER_SUCCESS)
+  if (camp_solver_update_model_state(y, md, -SMALL, TINY) !=
+      CAMP_SOLVER_SUCCESS) {
+    cell_stats_count_negative(sd, y, sd->cell_stats.neg_conc_rejections);
+    hw_counters_add(&(sd->hw_counters), HW_REGION_JAC, &jac_start_hw);
+    solver_trace_add(&(sd->trace), SOLVER_TRACE_JAC, jac_start__s,
+                     solver_timers_add(&(sd->timers), SOLVER_TIMER_JAC,
+                                       jac_start__s));
     return 1;
+  }
 
   // Get the current integrator time step (s)
   CVodeGetCurrentStep(sd->cvode_mem, &time_step);
 
-  // Reset the primary Jacobian
+  // Reset the primary Jacobian (CVODE zeroes the sparsity pattern along with
+  // the values before calling Jac())
   /// \todo #83 Figure out how to stop CVODE from resizing the Jacobian
   ///       during solving
-  SM_NNZ_S(J) = SM_NNZ_S(md->J_init);
-  for (int i = 0; i <= SM_NP_S(J); i++) {
-    (SM_INDEXPTRS_S(J))[i] = (SM_INDEXPTRS_S(md->J_init))[i];
-  }
-  for (int i = 0; i < SM_NNZ_S(J); i++) {
-    (SM_INDEXVALS_S(J))[i] = (SM_INDEXVALS_S(md->J_init))[i];
-    (SM_DATA_S(J))[i] = (realtype)0.0;
-  }
+  double start__s = phase_timing ? solver_timer_now() : 0.0;
+  jac_set_pattern(md, J);
 
-#ifdef CAMP_DEBUG
-  clock_t start2 = clock();
-#endif
+  start__s = phase_timer_add(sd, SOLVER_TIMER_JAC_ASSEMBLY, start__s);
 
 #ifdef CAMP_USE_GPU
   // Calculate the Jacobian
   rxn_calc_jac_gpu(md, J, time_step);
-#endif
-
-#ifdef CAMP_DEBUG
-  clock_t end2 = clock();
-  sd->timeJac += (end2 - start2);
+  start__s = phase_timer_add(sd, SOLVER_TIMER_RXN_JAC, start__s);
 #endif
 
   // Solving on CPU only
 
   // Loop over the grid cells to calculate sub-model and rxn Jacobians
+  // (the Jacobian blocks of grid cells left out of the integration stay
+  // zero)
   for (int i_cell = 0; i_cell < n_cells; ++i_cell) {
+    if (!sd->cell_active[i_cell]) continue;
+
     // Set the grid cell state pointers
     md->grid_cell_id = i_cell;
     md->grid_cell_state = &(md->total_state[i_cell * n_state_var]);
     md->grid_cell_env = &(md->total_env[i_cell * CAMP_NUM_ENV_PARAM_]);
     md->grid_cell_rxn_env_data =
-        &(md->rxn_env_data[i_cell * md->n_rxn_env_data]);
+        &(md->rxn_env_data[i_cell * md->n_cell_env_data]);
     md->grid_cell_aero_rep_env_data =
-        &(md->aero_rep_env_data[i_cell * md->n_aero_rep_env_data]);
+        &(md->aero_rep_env_data[i_cell * md->n_cell_env_data]);
     md->grid_cell_sub_model_env_data =
-        &(md->sub_model_env_data[i_cell * md->n_sub_model_env_data]);
+        &(md->sub_model_env_data[i_cell * md->n_cell_env_data]);
 
     // Reset the sub-model and reaction Jacobians
+    double cell_start__s = start__s;
     for (int i = 0; i < SM_NNZ_S(md->J_params); ++i)
       SM_DATA_S(md->J_params)[i] = 0.0;
     jacobian_reset(sd->jac);
+    start__s = phase_timer_add(sd, SOLVER_TIMER_JAC_ASSEMBLY, start__s);
 
     // Update the aerosol representations
-    aero_rep_update_state(md);
+    aero_rep_update_state_and_partials(md);
+    start__s = phase_timer_add(sd, SOLVER_TIMER_AERO_REP_UPDATE, start__s);
 
     // Run the sub models and get the sub-model Jacobian
     sub_model_calculate(md);
     sub_model_get_jac_contrib(md, J_param_data, time_step);
     CAMP_DEBUG_JAC(md->J_params, "sub-model Jacobian");
-
-#ifdef CAMP_DEBUG
-    clock_t start = clock();
-#endif
+    start__s = phase_timer_add(sd, SOLVER_TIMER_SUB_MODEL_CALC, start__s);
 
 #ifndef CAMP_USE_GPU
     // Calculate the reaction Jacobian
@@ -1086,11 +2162,8 @@ int Jac(realtype t, N_Vector y, N_Vector deriv, SUNMatrix J, void *solver_data,
     rxn_calc_jac_specific_types(md, sd->jac, time_step);
 #endif
 
-// rxn_calc_jac_specific_types(md, J_rxn_data, time_step);
-#ifdef CAMP_DEBUG
-    clock_t end = clock();
-    sd->timeJac += (end - start);
-#endif
+    // rxn_calc_jac_specific_types(md, J_rxn_data, time_step);
+    start__s = phase_timer_add(sd, SOLVER_TIMER_RXN_JAC, start__s);
 
     // Output the Jacobian to the SUNDIALS J_rxn
     jacobian_output(sd->jac, SM_DATA_S(md->J_rxn));
@@ -1105,13 +2178,22 @@ int Jac(realtype t, N_Vector y, N_Vector deriv, SUNMatrix J, void *solver_data,
           SM_DATA_S(md->J_rxn)[jac_map[i_map].rxn_id] *
           SM_DATA_S(md->J_params)[jac_map[i_map].param_id];
     CAMP_DEBUG_JAC(J, "solver Jacobian");
+    start__s = phase_timer_add(sd, SOLVER_TIMER_JAC_ASSEMBLY, start__s);
+    if (phase_timing)
+      sd->cell_stats.time__s[i_cell] += start__s - cell_start__s;
   }
 
-  // Save the Jacobian for use with derivative calculations
-  for (int i_elem = 0; i_elem < SM_NNZ_S(J); ++i_elem)
-    SM_DATA_S(md->J_solver)[i_elem] = SM_DATA_S(J)[i_elem];
+  // Save the Jacobian values for use with derivative calculations
+  for (int i_elem = 0; i_elem < n_cells * md->n_per_cell_solver_jac_elem;
+       ++i_elem)
+    md->J_solver_data[i_elem] = SM_DATA_S(J)[i_elem];
   N_VScale(1.0, y, md->J_state);
   N_VScale(1.0, deriv, md->J_deriv);
+  phase_timer_add(sd, SOLVER_TIMER_JAC_ASSEMBLY, start__s);
+  hw_counters_add(&(sd->hw_counters), HW_REGION_JAC, &jac_start_hw);
+  solver_trace_add(&(sd->trace), SOLVER_TRACE_JAC, jac_start__s,
+                   solver_timers_add(&(sd->timers), SOLVER_TIMER_JAC,
+                                     jac_start__s));
 
 #ifdef CAMP_DEBUG
   // Evaluate the Jacobian if flagged to do so
@@ -1331,6 +2413,7 @@ int guess_helper(const realtype t_n, const realtype h_n, N_Vector y_n,
 
   // Only try improvements when negative concentrations are predicted
   if (N_VMin(y_n) > -SMALL) return 0;
+  cell_stats_count_negative(sd, y_n, sd->cell_stats.guess_helper_activations);
 
   CAMP_DEBUG_PRINT_FULL("Trying to improve guess");
 
@@ -1406,8 +2489,98 @@ int guess_helper(const realtype t_n, const realtype h_n, N_Vector y_n,
 
   return 1;
 }
+
+/** \brief Call the guess helper and time it
+ *
+ * Arguments and return value are the same as for \c guess_helper()
+ */
+int timed_guess_helper(const realtype t_n, const realtype h_n, N_Vector y_n,
+                       N_Vector y_n1, N_Vector hf, void *solver_data,
+                       N_Vector tmp1, N_Vector corr) {
+  SolverData *sd = (SolverData *)solver_data;
+  double start__s = solver_timer_now();
+  int ret = guess_helper(t_n, h_n, y_n, y_n1, hf, solver_data, tmp1, corr);
+  solver_trace_add(
+      &(sd->trace), SOLVER_TRACE_GUESS_HELPER, start__s,
+      solver_timers_add(&(sd->timers), SOLVER_TIMER_GUESS_HELPER, start__s));
+  return ret;
+}
 #endif
 
+/* Linear solver operations with timing
+ *
+ * The operations structure must be the first member so SUNDIALS can free
+ * the wrapped operations along with the linear solver.
+ */
+typedef struct {
+  struct _generic_SUNLinearSolver_Ops ops;  // Operations used by SUNDIALS
+  int (*orig_setup)(SUNLinearSolver, SUNMatrix);  // Wrapped setup function
+  int (*orig_solve)(SUNLinearSolver, SUNMatrix, N_Vector, N_Vector,
+                    realtype);  // Wrapped solve function
+  SolverTimers *timers;         // Timers to update
+  SolverTrace *trace;           // Event trace to add to
+  HwCounters *hw_counters;      // Hardware event counts to update
+} TimedLinSolOps;
+
+/** \brief Set up the linear solver and time it
+ *
+ * KLU refactorizations reuse the pivot order of the last full factorization.
+ * If a refactorization fails, the factorization is recomputed from scratch.
+ */
+static int timed_linsol_setup(SUNLinearSolver S, SUNMatrix A) {
+  TimedLinSolOps *ops = (TimedLinSolOps *)S->ops;
+  double start__s = solver_timer_now();
+  HwCounterSample start_hw;
+  hw_counters_read(ops->hw_counters, &start_hw);
+  int ret = ops->orig_setup(S, A);
+  if (ret == SUNLS_PACKAGE_FAIL_REC &&
+      SUNKLUReInit(S, A, SM_NNZ_S(A), SUNKLU_REINIT_PARTIAL) == SUNLS_SUCCESS)
+    ret = ops->orig_setup(S, A);
+  hw_counters_add(ops->hw_counters, HW_REGION_LS_SETUP, &start_hw);
+  solver_trace_add(
+      ops->trace, SOLVER_TRACE_LS_SETUP, start__s,
+      solver_timers_add(ops->timers, SOLVER_TIMER_LS_SETUP, start__s));
+  return ret;
+}
+
+/** \brief Solve the linear system and time it */
+static int timed_linsol_solve(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                              N_Vector b, realtype tol) {
+  TimedLinSolOps *ops = (TimedLinSolOps *)S->ops;
+  double start__s = solver_timer_now();
+  HwCounterSample start_hw;
+  hw_counters_read(ops->hw_counters, &start_hw);
+  int ret = ops->orig_solve(S, A, x, b, tol);
+  hw_counters_add(ops->hw_counters, HW_REGION_LS_SOLVE, &start_hw);
+  solver_trace_add(
+      ops->trace, SOLVER_TRACE_LS_SOLVE, start__s,
+      solver_timers_add(ops->timers, SOLVER_TIMER_LS_SOLVE, start__s));
+  return ret;
+}
+
+/** \brief Wrap the linear solver setup and solve operations with timers and
+ *        hardware counters
+ *
+ * \param sd Pointer to the SolverData with a newly created linear solver
+ */
+static void solver_time_linear_solver(SolverData *sd) {
+  TimedLinSolOps *ops = (TimedLinSolOps *)malloc(sizeof(TimedLinSolOps));
+  if (ops == NULL) {
+    printf("\n\nERROR allocating space for linear solver timers\n\n");
+    exit(EXIT_FAILURE);
+  }
+  ops->ops = *(sd->ls->ops);
+  ops->orig_setup = sd->ls->ops->setup;
+  ops->orig_solve = sd->ls->ops->solve;
+  ops->timers = &(sd->timers);
+  ops->trace = &(sd->trace);
+  ops->hw_counters = &(sd->hw_counters);
+  ops->ops.setup = timed_linsol_setup;
+  ops->ops.solve = timed_linsol_solve;
+  free(sd->ls->ops);
+  sd->ls->ops = (SUNLinearSolver_Ops)ops;
+}
+
 /** \brief Create a sparse Jacobian matrix based on model data
  *
  * \param solver_data A pointer to the SolverData
@@ -1452,10 +2625,18 @@ SUNMatrix get_jac_init(SolverData *solver_data) {
     jacobian_register_element(&(solver_data->jac), i_spec, i_spec);
   }
 
+  // Set up the aerosol phase instances so the reactions can register the
+  // ones they use
+  aero_rep_initialize_cache(&(solver_data->model_data));
+
   // Fill in the 2D array of flags with Jacobian elements used by the
   // mechanism reactions for a single grid cell
   rxn_get_used_jac_elem(&(solver_data->model_data), &(solver_data->jac));
 
+  // Allocate the cached aerosol properties for the phase instances used by
+  // the reactions
+  aero_rep_build_cache(&(solver_data->model_data));
+
   // Build the sparse Jacobian
   if (jacobian_build_matrix(&(solver_data->jac)) != 1) {
     printf("\n\nERROR building sparse full-state Jacobian\n\n");
@@ -1483,25 +2664,57 @@ SUNMatrix get_jac_init(SolverData *solver_data) {
         jacobian_row_index(solver_data->jac, i_elem);
   }
 
-  // Build the set of time derivative ids
+  // Flag the solver variables
+  int *is_solver_var = (int *)malloc(sizeof(int) * n_state_var);
   int *deriv_ids = (int *)malloc(sizeof(int) * n_state_var);
-
-  if (deriv_ids == NULL) {
+  if (is_solver_var == NULL || deriv_ids == NULL) {
     printf("\n\nERROR allocating space for derivative ids\n\n");
     exit(EXIT_FAILURE);
   }
-  int i_dep_var = 0;
-  for (int i_spec = 0; i_spec < n_state_var; i_spec++) {
-    if (solver_data->model_data.var_type[i_spec] == CHEM_SPEC_VARIABLE) {
-      deriv_ids[i_spec] = i_dep_var++;
-    } else {
+  for (int i_spec = 0; i_spec < n_state_var; i_spec++)
+    is_solver_var[i_spec] =
+        solver_data->model_data.var_type[i_spec] == CHEM_SPEC_VARIABLE;
+
+  // Order the solver variables. The reverse Cuthill-McKee order of the
+  // reaction Jacobian is only used if it reduces the Jacobian bandwidth.
+  int *dep_var_ids = solver_data->model_data.dep_var_ids;
+  if (solver_data->model_data.var_order == SPECIES_ORDER_RCM &&
+      n_dep_var > 0) {
+    unsigned int *order =
+        (unsigned int *)malloc(sizeof(unsigned int) * n_dep_var);
+    if (order == NULL ||
+        species_order_rcm(solver_data->jac, is_solver_var, order) !=
+            n_dep_var) {
+      printf("\n\nERROR ordering the solver variables\n\n");
+      exit(EXIT_FAILURE);
+    }
+    for (int i_spec = 0; i_spec < n_state_var; i_spec++)
       deriv_ids[i_spec] = -1;
+    for (int i_dep = 0; i_dep < n_dep_var; i_dep++)
+      deriv_ids[dep_var_ids[i_dep]] = i_dep;
+    unsigned int state_bandwidth =
+        species_order_bandwidth(solver_data->jac, deriv_ids);
+    for (int i_dep = 0; i_dep < n_dep_var; i_dep++)
+      deriv_ids[order[i_dep]] = i_dep;
+    if (species_order_bandwidth(solver_data->jac, deriv_ids) <
+        state_bandwidth) {
+      for (int i_dep = 0; i_dep < n_dep_var; i_dep++)
+        dep_var_ids[i_dep] = (int)order[i_dep];
     }
+    free(order);
   }
 
+  // Build the set of time derivative ids
+  for (int i_spec = 0; i_spec < n_state_var; i_spec++) deriv_ids[i_spec] = -1;
+  for (int i_dep = 0; i_dep < n_dep_var; i_dep++)
+    deriv_ids[dep_var_ids[i_dep]] = i_dep;
+
   // Update the ids in the reaction data
   rxn_update_ids(&(solver_data->model_data), deriv_ids, solver_data->jac);
 
+  // Build the compact reaction data used during solving
+  rxn_build_compact_data(&(solver_data->model_data));
+
   ////////////////////////////////////////////////////////////////////////
   // Get the Jacobian elements used in sub model parameter calculations //
   ////////////////////////////////////////////////////////////////////////
@@ -1599,38 +2812,55 @@ SUNMatrix get_jac_init(SolverData *solver_data) {
 
   // Save the number of non-zero Jacobian elements
   n_jac_elem_solver = jacobian_number_of_elements(solver_jac);
-  solver_data->model_data.n_per_cell_solver_jac_elem = (int)n_jac_elem_solver;
 
-  // Initialize the sparse matrix (for solver state array including all cells)
-  SUNMatrix M = SUNSparseMatrix(n_dep_var_total, n_dep_var_total,
-                                n_jac_elem_solver * n_cells, CSC_MAT);
-  solver_data->model_data.J_solver = SUNSparseMatrix(
-      n_dep_var_total, n_dep_var_total, n_jac_elem_solver * n_cells, CSC_MAT);
+  free(is_solver_var);
+  solver_data->model_data.n_per_cell_solver_jac_elem = (int)n_jac_elem_solver;
 
-  // Set the column and row indices
-  for (unsigned int i_cell = 0; i_cell < n_cells; ++i_cell) {
-    for (unsigned int cell_col = 0; cell_col < n_state_var; ++cell_col) {
-      if (deriv_ids[cell_col] == -1) continue;
-      unsigned int i_col = deriv_ids[cell_col] + i_cell * n_dep_var;
-      (SM_INDEXPTRS_S(M))[i_col] =
-          (SM_INDEXPTRS_S(solver_data->model_data.J_solver))[i_col] =
-              jacobian_column_pointer_value(solver_jac, cell_col) +
-              i_cell * n_jac_elem_solver;
-    }
-    for (unsigned int cell_elem = 0; cell_elem < n_jac_elem_solver;
+  // Save the sparsity pattern for one grid cell (in solver variable order,
+  // with sorted rows in each column). It is shared by all grid cells, so only
+  // the Jacobian values are stored per cell.
+  int *col_ptrs = (int *)malloc(sizeof(int) * (n_dep_var + 1));
+  int *row_ids = (int *)malloc(sizeof(int) * (n_jac_elem_solver + 1));
+  int *elem_src = (int *)malloc(sizeof(int) * (n_jac_elem_solver + 1));
+  int *solver_elem_ids = (int *)malloc(sizeof(int) * (n_jac_elem_solver + 1));
+  solver_data->model_data.J_solver_data =
+      (double *)calloc(n_jac_elem_solver * n_cells + 1, sizeof(double));
+  if (col_ptrs == NULL || row_ids == NULL || elem_src == NULL ||
+      solver_elem_ids == NULL ||
+      solver_data->model_data.J_solver_data == NULL) {
+    printf("\n\nERROR allocating space for the solver Jacobian\n\n");
+    exit(EXIT_FAILURE);
+  }
+  int i_solver_elem = 0;
+  for (int i_col = 0; i_col < n_dep_var; ++i_col) {
+    unsigned int cell_col = (unsigned int)dep_var_ids[i_col];
+    col_ptrs[i_col] = i_solver_elem;
+    for (unsigned int cell_elem =
+             jacobian_column_pointer_value(solver_jac, cell_col);
+         cell_elem < jacobian_column_pointer_value(solver_jac, cell_col + 1);
          ++cell_elem) {
-      unsigned int i_elem = cell_elem + i_cell * n_jac_elem_solver;
-      (SM_DATA_S(M))[i_elem] =
-          (SM_DATA_S(solver_data->model_data.J_solver))[i_elem] = (realtype)0.0;
-      (SM_INDEXVALS_S(M))[i_elem] =
-          (SM_INDEXVALS_S(solver_data->model_data.J_solver))[i_elem] =
-              deriv_ids[jacobian_row_index(solver_jac, cell_elem)] +
-              i_cell * n_dep_var;
+      int row = deriv_ids[jacobian_row_index(solver_jac, cell_elem)];
+      int pos = i_solver_elem++;
+      while (pos > col_ptrs[i_col] && row_ids[pos - 1] > row) {
+        row_ids[pos] = row_ids[pos - 1];
+        elem_src[pos] = elem_src[pos - 1];
+        --pos;
+      }
+      row_ids[pos] = row;
+      elem_src[pos] = (int)cell_elem;
     }
   }
-  (SM_INDEXPTRS_S(M))[n_cells * n_dep_var] =
-      (SM_INDEXPTRS_S(solver_data->model_data.J_solver))[n_cells * n_dep_var] =
-          n_cells * n_jac_elem_solver;
+  col_ptrs[n_dep_var] = i_solver_elem;
+  for (int i_elem = 0; i_elem < i_solver_elem; ++i_elem)
+    solver_elem_ids[elem_src[i_elem]] = i_elem;
+  free(elem_src);
+  solver_data->model_data.jac_cell_col_ptrs = col_ptrs;
+  solver_data->model_data.jac_cell_row_ids = row_ids;
+
+  // Initialize the sparse matrix (for solver state array including all cells)
+  SUNMatrix M = SUNSparseMatrix(n_dep_var_total, n_dep_var_total,
+                                n_jac_elem_solver * n_cells, CSC_MAT);
+  jac_set_pattern(&(solver_data->model_data), M);
 
   // Allocate space for the map
   solver_data->model_data.n_mapped_values = n_mapped_values;
@@ -1660,7 +2890,7 @@ SUNMatrix get_jac_init(SolverData *solver_data) {
       if (solver_data->model_data.var_type[i_ind] == CHEM_SPEC_VARIABLE &&
           solver_data->model_data.var_type[i_dep] == CHEM_SPEC_VARIABLE) {
         map[i_mapped_value].solver_id =
-            jacobian_get_element_id(solver_jac, i_dep, i_ind);
+            solver_elem_ids[jacobian_get_element_id(solver_jac, i_dep, i_ind)];
         map[i_mapped_value].rxn_id = i_elem;
         map[i_mapped_value].param_id = 0;
         ++i_mapped_value;
@@ -1672,7 +2902,8 @@ SUNMatrix get_jac_init(SolverData *solver_data) {
         if (jacobian_get_element_id(param_jac, i_ind, j_ind) != -1 &&
             solver_data->model_data.var_type[j_ind] == CHEM_SPEC_VARIABLE) {
           map[i_mapped_value].solver_id =
-              jacobian_get_element_id(solver_jac, i_dep, j_ind);
+              solver_elem_ids[jacobian_get_element_id(solver_jac, i_dep,
+                                                      j_ind)];
           map[i_mapped_value].rxn_id = i_elem;
           map[i_mapped_value].param_id =
               jacobian_get_element_id(param_jac, i_ind, j_ind);
@@ -1698,6 +2929,10 @@ SUNMatrix get_jac_init(SolverData *solver_data) {
   solver_data->model_data.J_tmp = N_VClone(solver_data->y);
   solver_data->model_data.J_tmp2 = N_VClone(solver_data->y);
 
+  // Create working vectors for calls to Jac() outside the solver
+  solver_data->jac_tmp1 = N_VClone(solver_data->y);
+  solver_data->jac_tmp2 = N_VClone(solver_data->y);
+
   // Initialize the Jacobian state and derivative arrays to zero
   // for use before the first call to Jac()
   N_VConst(0.0, solver_data->model_data.J_state);
@@ -1706,6 +2941,7 @@ SUNMatrix get_jac_init(SolverData *solver_data) {
   // Free the memory used
   jacobian_free(&param_jac);
   jacobian_free(&solver_jac);
+  free(solver_elem_ids);
   free(deriv_ids);
 
   return M;
@@ -1764,12 +3000,8 @@ void check_flag_fail(void *flag_value, char *func_name, int opt) {
 void solver_reset_timers(void *solver_data) {
   SolverData *sd = (SolverData *)solver_data;
 
-#ifdef CAMP_DEBUG
-  sd->counterDeriv = 0;
-  sd->counterJac = 0;
-  sd->timeDeriv = 0;
-  sd->timeJac = 0;
-#endif
+  solver_timers_reset(&(sd->timers));
+  hw_counters_reset(&(sd->hw_counters));
 }
 #endif
 
@@ -1845,20 +3077,39 @@ void solver_free(void *solver_data) {
   // free the Jacobian
   jacobian_free(&(sd->jac));
 
+  // free the subsystem decomposition
+  subsystems_free(&(sd->subsystems));
+
   // free the derivative vectors
   N_VDestroy(sd->y);
   N_VDestroy(sd->deriv);
+  N_VDestroy(sd->jac_tmp1);
+  N_VDestroy(sd->jac_tmp2);
 
   // destroy the Jacobian marix
   SUNMatDestroy(sd->J);
 
-  // destroy Jacobian matrix for guessing state
-  SUNMatDestroy(sd->J_guess);
-
   // free the linear solver
   SUNLinSolFree(sd->ls);
+
+  // free the grid cell flags
+  free(sd->cell_active);
+
+  // free the per-cell statistics
+  free(sd->cell_stats.rhs_contribs);
+  free(sd->cell_stats.neg_conc_rejections);
+  free(sd->cell_stats.guess_helper_activations);
+  free(sd->cell_stats.time__s);
+  free(sd->cell_stats.err_norm);
+  free(sd->cell_stats.env_updates);
 #endif
 
+  // write and free the event trace
+  solver_trace_free(&(sd->trace));
+
+  // close the hardware counters
+  hw_counters_free(&(sd->hw_counters));
+
   // Free the allocated ModelData
   model_free(sd->model_data);
 
@@ -1869,32 +3120,60 @@ void solver_free(void *solver_data) {
 #ifdef CAMP_USE_SUNDIALS
 /** \brief Determine if there is anything to solve
  *
- * If the solver state concentrations and the derivative vector are very small,
- * there is no point running the solver
+ * Each grid cell is checked separately. If the solver state concentrations
+ * and the derivative of a grid cell are very small, the grid cell is left out
+ * of the integration. If a quiescence tolerance is set and the change in every
+ * solver variable of a grid cell over the time step is small relative to its
+ * integration tolerance, the grid cell is updated with one explicit Euler step
+ * and left out of the integration.
+ *
+ * \param sd Pointer to the SolverData object
+ * \param t_initial Initial time (s)
+ * \param t_final Final time (s)
+ * \return true if any grid cell needs to be integrated
  */
 bool is_anything_going_on_here(SolverData *sd, realtype t_initial,
                                realtype t_final) {
   ModelData *md = &(sd->model_data);
+  int n_dep_var = md->n_per_cell_dep_var;
+  realtype time_step = t_final - t_initial;
+  realtype rel_tol = ((CVodeMem)sd->cvode_mem)->cv_reltol;
+  realtype explicit_tol = (realtype)sd->quiescence_tol;
+  bool any_active = false;
 
-  if (f(t_initial, sd->y, sd->deriv, sd)) {
-    int i_dep_var = 0;
-    for (int i_cell = 0; i_cell < md->n_cells; ++i_cell) {
-      for (int i_spec = 0; i_spec < md->n_per_cell_state_var; ++i_spec) {
-        if (md->var_type[i_spec] == CHEM_SPEC_VARIABLE) {
-          if (NV_Ith_S(sd->y, i_dep_var) >
-              NV_Ith_S(sd->abs_tol_nv, i_dep_var) * 1.0e-10)
-            return true;
-          if (NV_Ith_S(sd->deriv, i_dep_var) * (t_final - t_initial) >
-              NV_Ith_S(sd->abs_tol_nv, i_dep_var) * 1.0e-10)
-            return true;
-          i_dep_var++;
-        }
+  // The derivative can only be calculated for the full set of grid cells
+  if (f(t_initial, sd->y, sd->deriv, sd) != 0) return true;
+
+  for (int i_cell = 0; i_cell < md->n_cells; ++i_cell) {
+    realtype *cell_y = &(NV_DATA_S(sd->y)[i_cell * n_dep_var]);
+    realtype *cell_deriv = &(NV_DATA_S(sd->deriv)[i_cell * n_dep_var]);
+    realtype *cell_abs_tol = &(NV_DATA_S(sd->abs_tol_nv)[i_cell * n_dep_var]);
+    bool is_empty = true;
+    bool is_quiescent = explicit_tol > ZERO;
+    for (int i_dep = 0; i_dep < n_dep_var; ++i_dep) {
+      realtype change = cell_deriv[i_dep] * time_step;
+      if (cell_y[i_dep] > cell_abs_tol[i_dep] * 1.0e-10 ||
+          change > cell_abs_tol[i_dep] * 1.0e-10)
+        is_empty = false;
+      if (fabs(change) > explicit_tol * (cell_abs_tol[i_dep] +
+                                         rel_tol * fabs(cell_y[i_dep])))
+        is_quiescent = false;
+    }
+    if (is_empty) {
+      sd->cell_active[i_cell] = 0;
+    } else if (is_quiescent) {
+      for (int i_dep = 0; i_dep < n_dep_var; ++i_dep) {
+        realtype conc = cell_y[i_dep] + cell_deriv[i_dep] * time_step;
+        cell_y[i_dep] = conc > ZERO ? conc : ZERO;
       }
+      sd->cell_active[i_cell] = 0;
+      ++sd->n_explicit_cells;
+    } else {
+      any_active = true;
     }
-    return false;
   }
 
-  return true;
+  return any_active;
 }
 #endif
 
@@ -1918,11 +3197,12 @@ void model_free(ModelData model_data) {
 #endif
 
 #ifdef CAMP_USE_SUNDIALS
-  // Destroy the initialized Jacbobian matrix
-  SUNMatDestroy(model_data.J_init);
+  // Destroy the Jacobian matrices and sparsity pattern
+  free(model_data.jac_cell_col_ptrs);
+  free(model_data.jac_cell_row_ids);
   SUNMatDestroy(model_data.J_rxn);
   SUNMatDestroy(model_data.J_params);
-  SUNMatDestroy(model_data.J_solver);
+  free(model_data.J_solver_data);
   N_VDestroy(model_data.J_state);
   N_VDestroy(model_data.J_deriv);
   N_VDestroy(model_data.J_tmp);
@@ -1930,29 +3210,11 @@ void model_free(ModelData model_data) {
 #endif
   free(model_data.jac_map);
   free(model_data.jac_map_params);
-  free(model_data.var_type);
-  free(model_data.rxn_int_data);
-  free(model_data.rxn_float_data);
-  free(model_data.rxn_env_data);
-  free(model_data.rxn_int_indices);
-  free(model_data.rxn_float_indices);
-  free(model_data.rxn_env_idx);
-  free(model_data.aero_phase_int_data);
-  free(model_data.aero_phase_float_data);
-  free(model_data.aero_phase_int_indices);
-  free(model_data.aero_phase_float_indices);
-  free(model_data.aero_rep_int_data);
-  free(model_data.aero_rep_float_data);
-  free(model_data.aero_rep_env_data);
-  free(model_data.aero_rep_int_indices);
-  free(model_data.aero_rep_float_indices);
-  free(model_data.aero_rep_env_idx);
-  free(model_data.sub_model_int_data);
-  free(model_data.sub_model_float_data);
-  free(model_data.sub_model_env_data);
-  free(model_data.sub_model_int_indices);
-  free(model_data.sub_model_float_indices);
-  free(model_data.sub_model_env_idx);
+  // Free the variable, reaction, aerosol and sub-model data arrays
+  arena_free(&(model_data.arena));
+  aero_rep_free_cache(&model_data);
+  rxn_free_rate_table(&model_data);
+  cost_profile_free(&(model_data.cost_profile));
 }
 
 /** \brief Free update data
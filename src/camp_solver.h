@@ -12,6 +12,15 @@
 #define CAMP_SOLVER_H_
 #include "camp_common.h"
 
+/* Kernels timed by solver_benchmark() (the order must match the kernel
+ * indices in the camp_solver_data module) */
+typedef enum {
+  SOLVER_BENCH_UPDATE_ENV_STATE,  // Updates for a new environmental state
+  SOLVER_BENCH_DERIV,             // Calls to f()
+  SOLVER_BENCH_JAC,               // Calls to Jac()
+  SOLVER_BENCH_NUM_KERNELS
+} SolverBenchmarkKernel;
+
 /* Functions called by camp-chem */
 void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
                  int n_rxn_int_param, int n_rxn_float_param,
@@ -20,15 +29,43 @@ void *solver_new(int n_state_var, int n_cells, int *var_type, int n_rxn,
                  int n_aero_rep, int n_aero_rep_int_param,
                  int n_aero_rep_float_param, int n_aero_rep_env_param,
                  int n_sub_model, int n_sub_model_int_param,
-                 int n_sub_model_float_param, int n_sub_model_env_param);
+                 int n_sub_model_float_param, int n_sub_model_env_param,
+                 int huge_pages, int var_order);
 void solver_initialize(void *solver_data, double *abs_tol, double rel_tol,
                        int max_steps, int max_conv_fails);
 #ifdef CAMP_DEBUG
 int solver_set_debug_out(void *solver_data, bool do_output);
 int solver_set_eval_jac(void *solver_data, bool eval_Jac);
 #endif
+int solver_set_rate_table(void *solver_data, int n_temp, double temp_min__K,
+                          double temp_max__K, int n_press,
+                          double press_min__Pa, double press_max__Pa,
+                          double tolerance);
+void solver_get_rate_table_info(void *solver_data, int *num_rxn,
+                                double *max_rel_error);
+int solver_set_quiescence(void *solver_data, double tolerance);
+int solver_set_cost_profile(void *solver_data, int level);
+int solver_set_phase_timing(void *solver_data, int phase_timing);
+int solver_start_trace(void *solver_data, char *file_name, int process_id,
+                       int thread_id, int max_events);
+int solver_start_hw_counters(void *solver_data);
+void solver_get_hw_counters(void *solver_data, long long *counts,
+                            int *calls);
+void solver_get_memory_report(void *solver_data, long long *fixed_bytes,
+                              long long *per_cell_bytes);
+void solver_get_cell_statistics(void *solver_data, int *rhs_contribs,
+                                int *neg_conc_rejections,
+                                int *guess_helper_activations, double *time__s,
+                                double *err_norm, int *env_updates);
+void solver_get_cost_profile(void *solver_data, double *rxn_type_time__s,
+                             long int *rxn_type_calls,
+                             double *sub_model_type_time__s,
+                             long int *sub_model_type_calls,
+                             double *rxn_time__s, long int *rxn_calls);
 int solver_run(void *solver_data, double *state, double *env, double t_initial,
                double t_final);
+int solver_benchmark(void *solver_data, double *state, double *env,
+                     int n_repeat, double *mean_time__s, double *min_time__s);
 void solver_get_statistics(void *solver_data, int *solver_flag, int *num_steps,
                            int *RHS_evals, int *LS_setups,
                            int *error_test_fails, int *NLS_iters,
@@ -38,6 +75,10 @@ void solver_get_statistics(void *solver_data, int *solver_flag, int *num_steps,
                            int *RHS_evals_total, int *Jac_evals_total,
                            double *RHS_time__s, double *Jac_time__s,
                            double *max_loss_precision);
+void solver_get_subsystem_info(void *solver_data, int *num_blocks,
+                               int *num_groups, int *largest_block);
+void solver_get_timers(void *solver_data, double *phase_time__s,
+                       int *phase_calls);
 void solver_free(void *solver_data);
 void model_free(ModelData model_data);
 
@@ -49,6 +90,9 @@ int Jac(realtype t, N_Vector y, N_Vector deriv, SUNMatrix J, void *model_data,
 int guess_helper(const realtype t_n, const realtype h_n, N_Vector y_n,
                  N_Vector y_n1, N_Vector hf, void *solver_data, N_Vector tmp1,
                  N_Vector corr);
+int timed_guess_helper(const realtype t_n, const realtype h_n, N_Vector y_n,
+                       N_Vector y_n1, N_Vector hf, void *solver_data,
+                       N_Vector tmp1, N_Vector corr);
 void error_handler(int error_code, const char *module, const char *function,
                    char *msg, void *sd);
 
@@ -62,6 +106,14 @@ bool check_Jac(realtype t, N_Vector y, SUNMatrix J, N_Vector deriv,
 int check_flag(void *flag_value, char *func_name, int opt);
 void check_flag_fail(void *flag_value, char *func_name, int opt);
 void solver_reset_timers(void *solver_data);
+static void solver_time_linear_solver(SolverData *sd);
+static void solver_set_state(SolverData *sd, double *state, double *env);
+static void solver_get_state(SolverData *sd, double *state);
+static void solver_update_env_state(SolverData *sd);
+static void cell_stats_reset(SolverData *sd);
+static void cell_stats_count_negative(SolverData *sd, N_Vector y,
+                                      int *counter);
+static void cell_stats_set_err_norm(SolverData *sd);
 static void solver_print_stats(void *cvode_mem);
 static void print_data_sizes(ModelData *md);
 static void print_jacobian(SUNMatrix M);
@@ -0,0 +1,93 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Reaction and sub-model cost profile functions
+ *
+ */
+/** \file
+ * \brief Reaction and sub-model cost profile functions
+ */
+#include "cost_profile.h"
+#include <stdlib.h>
+#include "solver_timers.h"
+
+void cost_profile_initialize(CostProfile *profile, int n_rxn) {
+  profile->level = COST_PROFILE_OFF;
+  profile->n_rxn = n_rxn;
+  profile->rxn_time__s = NULL;
+  profile->rxn_calls = NULL;
+  cost_profile_reset(profile);
+}
+
+int cost_profile_set_level(CostProfile *profile, int level) {
+  if (level < COST_PROFILE_OFF || level > COST_PROFILE_BY_RXN) return 0;
+  if (level == COST_PROFILE_BY_RXN && profile->rxn_time__s == NULL &&
+      profile->n_rxn > 0) {
+    profile->rxn_time__s = (double *)malloc(
+        profile->n_rxn * COST_PROFILE_NUM_PHASES * sizeof(double));
+    profile->rxn_calls = (long int *)malloc(
+        profile->n_rxn * COST_PROFILE_NUM_PHASES * sizeof(long int));
+    if (profile->rxn_time__s == NULL || profile->rxn_calls == NULL) {
+      cost_profile_free(profile);
+      return 0;
+    }
+  }
+  profile->level = level;
+  cost_profile_reset(profile);
+  return 1;
+}
+
+void cost_profile_reset(CostProfile *profile) {
+  for (int i = 0; i < COST_PROFILE_MAX_RXN_TYPE * COST_PROFILE_NUM_PHASES;
+       ++i) {
+    profile->rxn_type_time__s[i] = 0.0;
+    profile->rxn_type_calls[i] = 0;
+  }
+  for (int i = 0; i < COST_PROFILE_MAX_SUB_MODEL_TYPE * COST_PROFILE_NUM_PHASES;
+       ++i) {
+    profile->sub_model_type_time__s[i] = 0.0;
+    profile->sub_model_type_calls[i] = 0;
+  }
+  if (profile->rxn_time__s == NULL) return;
+  for (int i = 0; i < profile->n_rxn * COST_PROFILE_NUM_PHASES; ++i) {
+    profile->rxn_time__s[i] = 0.0;
+    profile->rxn_calls[i] = 0;
+  }
+}
+
+double cost_profile_add_rxn(CostProfile *profile, CostProfilePhase phase,
+                            int rxn_type, int rxn_id, double start__s) {
+  double now__s = solver_timer_now();
+  double elapsed__s = now__s - start__s;
+  if (rxn_type >= 0 && rxn_type < COST_PROFILE_MAX_RXN_TYPE) {
+    int i = rxn_type * COST_PROFILE_NUM_PHASES + phase;
+    profile->rxn_type_time__s[i] += elapsed__s;
+    ++(profile->rxn_type_calls[i]);
+  }
+  if (profile->level == COST_PROFILE_BY_RXN) {
+    int i = rxn_id * COST_PROFILE_NUM_PHASES + phase;
+    profile->rxn_time__s[i] += elapsed__s;
+    ++(profile->rxn_calls[i]);
+  }
+  return now__s;
+}
+
+double cost_profile_add_sub_model(CostProfile *profile, CostProfilePhase phase,
+                                  int sub_model_type, double start__s) {
+  double now__s = solver_timer_now();
+  if (sub_model_type >= 0 && sub_model_type < COST_PROFILE_MAX_SUB_MODEL_TYPE) {
+    int i = sub_model_type * COST_PROFILE_NUM_PHASES + phase;
+    profile->sub_model_type_time__s[i] += now__s - start__s;
+    ++(profile->sub_model_type_calls[i]);
+  }
+  return now__s;
+}
+
+void cost_profile_free(CostProfile *profile) {
+  free(profile->rxn_time__s);
+  free(profile->rxn_calls);
+  profile->rxn_time__s = NULL;
+  profile->rxn_calls = NULL;
+  profile->level = COST_PROFILE_OFF;
+}
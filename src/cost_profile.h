@@ -0,0 +1,101 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the reaction and sub-model cost profile and related functions
+ *
+ */
+/** \file
+ * \brief Header for the reaction and sub-model cost profile and related
+ *        functions
+ */
+#ifndef COST_PROFILE_H_
+#define COST_PROFILE_H_
+
+// Number of reaction and sub-model type slots (type ids must be smaller than
+// these; must match the parameters in the camp_cost_profile module)
+#define COST_PROFILE_MAX_RXN_TYPE 32
+#define COST_PROFILE_MAX_SUB_MODEL_TYPE 8
+
+// Profiling levels (must match the parameters in the camp_cost_profile module)
+#define COST_PROFILE_OFF 0
+#define COST_PROFILE_BY_TYPE 1
+#define COST_PROFILE_BY_RXN 2
+
+/* Profiled calculations (the order must match the phase index in the
+ * camp_cost_profile module) */
+typedef enum {
+  COST_PROFILE_DERIV,  // Reaction derivatives or sub-model calculations
+  COST_PROFILE_JAC,    // Reaction or sub-model Jacobian contributions
+  COST_PROFILE_NUM_PHASES
+} CostProfilePhase;
+
+/* Accumulated wall-clock time and number of calls for each reaction type,
+ * sub-model type and, optionally, each reaction
+ *
+ * Arrays are ordered with the phase varying fastest.
+ */
+typedef struct {
+  int level;  // Profiling level (COST_PROFILE_OFF, _BY_TYPE or _BY_RXN)
+  double rxn_type_time__s[COST_PROFILE_MAX_RXN_TYPE * COST_PROFILE_NUM_PHASES];
+  long int rxn_type_calls[COST_PROFILE_MAX_RXN_TYPE * COST_PROFILE_NUM_PHASES];
+  double sub_model_type_time__s[COST_PROFILE_MAX_SUB_MODEL_TYPE *
+                                COST_PROFILE_NUM_PHASES];
+  long int sub_model_type_calls[COST_PROFILE_MAX_SUB_MODEL_TYPE *
+                                COST_PROFILE_NUM_PHASES];
+  int n_rxn;              // Number of reactions
+  double *rxn_time__s;    // Time for each reaction (s) (COST_PROFILE_BY_RXN)
+  long int *rxn_calls;    // Calls for each reaction (COST_PROFILE_BY_RXN)
+} CostProfile;
+
+/** \brief Initialize a cost profile with profiling turned off
+ *
+ * \param profile Pointer to the CostProfile object
+ * \param n_rxn Number of reactions in the model
+ */
+void cost_profile_initialize(CostProfile *profile, int n_rxn);
+
+/** \brief Set the profiling level and reset the profile
+ *
+ * \param profile Pointer to the CostProfile object
+ * \param level New profiling level
+ * \return Flag indicating whether the level was set (0 = false; 1 = true)
+ */
+int cost_profile_set_level(CostProfile *profile, int level);
+
+/** \brief Reset all the accumulated times and calls
+ *
+ * \param profile Pointer to the CostProfile object
+ */
+void cost_profile_reset(CostProfile *profile);
+
+/** \brief Add the time elapsed since a start time to a reaction
+ *
+ * \param profile Pointer to the CostProfile object
+ * \param phase Profiled calculation
+ * \param rxn_type Reaction type id
+ * \param rxn_id Reaction index
+ * \param start__s Start time (s) from \c solver_timer_now()
+ * \return Current time (s), for use as the start time of a following call
+ */
+double cost_profile_add_rxn(CostProfile *profile, CostProfilePhase phase,
+                            int rxn_type, int rxn_id, double start__s);
+
+/** \brief Add the time elapsed since a start time to a sub-model type
+ *
+ * \param profile Pointer to the CostProfile object
+ * \param phase Profiled calculation
+ * \param sub_model_type Sub-model type id
+ * \param start__s Start time (s) from \c solver_timer_now()
+ * \return Current time (s), for use as the start time of a following call
+ */
+double cost_profile_add_sub_model(CostProfile *profile, CostProfilePhase phase,
+                                  int sub_model_type, double start__s);
+
+/** \brief Free memory associated with a CostProfile object
+ *
+ * \param profile Pointer to the CostProfile object
+ */
+void cost_profile_free(CostProfile *profile);
+
+#endif
@@ -30,7 +30,8 @@ typedef struct {
 
 /* Model element data and indices */
 typedef struct {
-  int n_cells;  // number of grid cells
+  int n_cells;     // number of grid cells
+  int env_stride;  // distance between the environmental data of two cells
 
   ModelElementDataPointers ptrs;
   ModelElementDataIndices indices;
@@ -81,9 +82,9 @@ void allocate_index_arrays(ModelElement *model_element, int num_elements) {
 
 // Attach to a set of data
 void attach_to_data(ModelElement *model_element, int num_elements,
-                    int num_cells, int *int_data, double *float_data,
-                    double *env_data, int *int_indices, int *float_indices,
-                    int *env_indices) {
+                    int num_cells, int env_stride, int *int_data,
+                    double *float_data, double *env_data, int *int_indices,
+                    int *float_indices, int *env_indices) {
   // allocate the index arrays
   allocate_index_arrays(model_element, num_elements);
 
@@ -96,6 +97,7 @@ void attach_to_data(ModelElement *model_element, int num_elements,
 
   // set the number of grid cells
   model_element->n_cells = num_cells;
+  model_element->env_stride = env_stride;
 
   // set data pointers
   model_element->ptrs.int_data = int_data;
@@ -115,8 +117,9 @@ void copy_data(ModelElement from, ModelElement *to) {
     to->indices.env_data[i] = from.indices.env_data[i];
   }
 
-  // set the number of grid cells
+  // set the number of grid cells (the copy is stored without padding)
   to->n_cells = from.n_cells;
+  to->env_stride = to->indices.env_data[to->indices.n_elements];
 
   // allocate the data arrays
   to->ptrs.int_data =
@@ -144,9 +147,10 @@ void copy_data(ModelElement from, ModelElement *to) {
     to->ptrs.int_data[i] = from.ptrs.int_data[i];
   for (int i = 0; i < to->indices.float_data[to->indices.n_elements]; ++i)
     to->ptrs.float_data[i] = from.ptrs.float_data[i];
-  for (int i = 0;
-       i < to->indices.env_data[to->indices.n_elements] * to->n_cells; ++i)
-    to->ptrs.env_data[i] = from.ptrs.env_data[i];
+  for (int i_cell = 0; i_cell < to->n_cells; ++i_cell)
+    for (int i = 0; i < to->indices.env_data[to->indices.n_elements]; ++i)
+      to->ptrs.env_data[i_cell * to->env_stride + i] =
+          from.ptrs.env_data[i_cell * from.env_stride + i];
 }
 
 // Initialize the difference checker data
@@ -159,19 +163,22 @@ void diff_check_init(ModelData model_data) {
 
   // Point to the actual model data
   attach_to_data(&dd->current.reactions, model_data.n_rxn, model_data.n_cells,
-                 model_data.rxn_int_data, model_data.rxn_float_data,
-                 model_data.rxn_env_data, model_data.rxn_int_indices,
-                 model_data.rxn_float_indices, model_data.rxn_env_idx);
+                 model_data.n_cell_env_data, model_data.rxn_int_data,
+                 model_data.rxn_float_data, model_data.rxn_env_data,
+                 model_data.rxn_int_indices, model_data.rxn_float_indices,
+                 model_data.rxn_env_idx);
   attach_to_data(
       &dd->current.aero_reps, model_data.n_aero_rep, model_data.n_cells,
-      model_data.aero_rep_int_data, model_data.aero_rep_float_data,
-      model_data.aero_rep_env_data, model_data.aero_rep_int_indices,
-      model_data.aero_rep_float_indices, model_data.aero_rep_env_idx);
+      model_data.n_cell_env_data, model_data.aero_rep_int_data,
+      model_data.aero_rep_float_data, model_data.aero_rep_env_data,
+      model_data.aero_rep_int_indices, model_data.aero_rep_float_indices,
+      model_data.aero_rep_env_idx);
   attach_to_data(
       &dd->current.sub_models, model_data.n_sub_model, model_data.n_cells,
-      model_data.sub_model_int_data, model_data.sub_model_float_data,
-      model_data.sub_model_env_data, model_data.sub_model_int_indices,
-      model_data.sub_model_float_indices, model_data.sub_model_env_idx);
+      model_data.n_cell_env_data, model_data.sub_model_int_data,
+      model_data.sub_model_float_data, model_data.sub_model_env_data,
+      model_data.sub_model_int_indices, model_data.sub_model_float_indices,
+      model_data.sub_model_env_idx);
 
   // Create a set of data to hold the previous values
   copy_data(dd->current.reactions, &dd->last_check.reactions);
@@ -283,11 +290,9 @@ int compare_and_update(ModelElement current, ModelElement *last_check,
     }
     for (int i_cell = 0; i_cell < current.n_cells; ++i_cell) {
       double *curr_env_ptr =
-          current.ptrs.env_data +
-          i_cell * current.indices.env_data[current.indices.n_elements];
+          current.ptrs.env_data + i_cell * current.env_stride;
       double *last_env_ptr =
-          last_check->ptrs.env_data +
-          i_cell * last_check->indices.env_data[last_check->indices.n_elements];
+          last_check->ptrs.env_data + i_cell * last_check->env_stride;
       count = 0;
       for (int i = last_check->indices.env_data[e];
            i < last_check->indices.env_data[e + 1]; ++i) {
@@ -0,0 +1,310 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Host-layout state functions
+ *
+ * These functions move tracer concentrations between a host model array and
+ * the solver without going through a per-cell copy on the host side.
+ *
+ */
+/** \file
+ * \brief Host-layout state functions
+ */
+#include "host_state.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "camp_common.h"
+
+/** \brief Copy one tracer for a set of grid cells from the host array
+ *
+ * \param host_tracer Host array at the tracer offset
+ * \param cell_offsets Host array offset of each grid cell
+ * \param n_cells Number of grid cells to copy
+ * \param dest First value to set
+ * \param dest_stride Distance between the values of two grid cells in dest
+ * \param add Flag indicating whether to add to dest instead of setting it
+ */
+static void host_state_transpose_in(const float *restrict host_tracer,
+                                    const long *restrict cell_offsets,
+                                    int n_cells, double *restrict dest,
+                                    int dest_stride, bool add) {
+  if (add) {
+    for (int i_cell = 0; i_cell < n_cells; ++i_cell)
+      dest[i_cell * dest_stride] += (double)host_tracer[cell_offsets[i_cell]];
+  } else {
+    for (int i_cell = 0; i_cell < n_cells; ++i_cell)
+      dest[i_cell * dest_stride] = (double)host_tracer[cell_offsets[i_cell]];
+  }
+}
+
+/** \brief Copy one species for a set of grid cells to the host array
+ *
+ * \param src First value to copy
+ * \param src_stride Distance between the values of two grid cells in src
+ * \param cell_offsets Host array offset of each grid cell
+ * \param n_cells Number of grid cells to copy
+ * \param host_tracer Host array at the tracer offset
+ */
+static void host_state_transpose_out(const double *restrict src,
+                                     int src_stride,
+                                     const long *restrict cell_offsets,
+                                     int n_cells, float *restrict host_tracer) {
+  for (int i_cell = 0; i_cell < n_cells; ++i_cell)
+    host_tracer[cell_offsets[i_cell]] = (float)src[i_cell * src_stride];
+}
+
+/** \brief Check a range of host grid cells to pack or unpack
+ *
+ * \param map Host state map
+ * \param md Model data
+ * \param first_cell Index of the first host grid cell
+ * \param n_pack_cells Number of host grid cells
+ */
+static void host_state_check_cells(HostStateMap *map, ModelData *md,
+                                   int first_cell, int n_pack_cells) {
+  if (n_pack_cells < 1 || n_pack_cells > md->n_cells) {
+    printf("\n\nERROR Cannot pack %d grid cells for a solver with %d grid "
+           "cells\n\n",
+           n_pack_cells, md->n_cells);
+    exit(EXIT_FAILURE);
+  }
+  if (first_cell < 0 || first_cell + n_pack_cells > map->n_host_cells) {
+    printf("\n\nERROR Grid cells %d to %d are not on the host array\n\n",
+           first_cell, first_cell + n_pack_cells - 1);
+    exit(EXIT_FAILURE);
+  }
+}
+
+/** \brief Create a map between a host tracer array and the solver state
+ *
+ * Must be called after the solver has been initialized.
+ *
+ * \param solver_data Pointer to the initialized solver data
+ * \param n_pair Number of (tracer, species) pairs
+ * \param state_ids State variable id in a grid cell of each pair
+ * \param tracer_offsets Offset of the tracer in a grid cell on the host array
+ *                       for each pair
+ * \param n_host_cells Number of grid cells on the host array
+ * \param cell_offsets Offset of each grid cell on the host array
+ * \return Pointer to the new map
+ */
+void *host_state_map_new(void *solver_data, int n_pair, int *state_ids,
+                         long *tracer_offsets, int n_host_cells,
+                         long *cell_offsets) {
+  SolverData *sd = (SolverData *)solver_data;
+  ModelData *md = &(sd->model_data);
+  int n_state_var = md->n_per_cell_state_var;
+  int n_dep_var = md->n_per_cell_dep_var;
+
+  HostStateMap *map = (HostStateMap *)malloc(sizeof(HostStateMap));
+  int *solver_id = (int *)malloc(n_state_var * sizeof(int));
+  int *is_set = (int *)calloc(n_state_var, sizeof(int));
+  if (map == NULL || solver_id == NULL || is_set == NULL) {
+    printf("\n\nERROR allocating space for host state map\n\n");
+    exit(EXIT_FAILURE);
+  }
+  map->n_host_cells = n_host_cells;
+  map->cell_offsets = (long *)malloc(n_host_cells * sizeof(long));
+  map->dep_ids = (int *)malloc(n_pair * sizeof(int));
+  map->dep_tracer_offsets = (long *)malloc(n_pair * sizeof(long));
+  map->state_ids = (int *)malloc(n_pair * sizeof(int));
+  map->state_tracer_offsets = (long *)malloc(n_pair * sizeof(long));
+  map->unmapped_dep_ids = (int *)malloc(n_dep_var * sizeof(int));
+  if (map->cell_offsets == NULL || map->dep_ids == NULL ||
+      map->dep_tracer_offsets == NULL || map->state_ids == NULL ||
+      map->state_tracer_offsets == NULL || map->unmapped_dep_ids == NULL) {
+    printf("\n\nERROR allocating space for host state map\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i_cell = 0; i_cell < n_host_cells; ++i_cell)
+    map->cell_offsets[i_cell] = cell_offsets[i_cell];
+
+  // Solver variable id of each state variable
+  for (int i_spec = 0; i_spec < n_state_var; ++i_spec) solver_id[i_spec] = -1;
+  for (int i_dep = 0; i_dep < n_dep_var; ++i_dep)
+    solver_id[md->dep_var_ids[i_dep]] = i_dep;
+
+  // Pairs that set their species come before pairs that add to it
+  // (is_set holds the index + 1 of the pair that sets each species)
+  map->n_dep = 0;
+  map->n_state = 0;
+  for (int add = 0; add < 2; ++add) {
+    for (int i_pair = 0; i_pair < n_pair; ++i_pair) {
+      int spec = state_ids[i_pair];
+      if (spec < 0 || spec >= n_state_var) {
+        printf("\n\nERROR Invalid state id %d in host state map\n\n", spec);
+        exit(EXIT_FAILURE);
+      }
+      if (add == 0) {
+        if (is_set[spec] != 0) continue;
+        is_set[spec] = i_pair + 1;
+      } else if (is_set[spec] == i_pair + 1) {
+        continue;
+      }
+      if (solver_id[spec] >= 0) {
+        map->dep_ids[map->n_dep] = solver_id[spec];
+        map->dep_tracer_offsets[map->n_dep++] = tracer_offsets[i_pair];
+      } else {
+        map->state_ids[map->n_state] = spec;
+        map->state_tracer_offsets[map->n_state++] = tracer_offsets[i_pair];
+      }
+    }
+    if (add == 0) {
+      map->n_dep_assign = map->n_dep;
+      map->n_state_assign = map->n_state;
+    }
+  }
+
+  // Solver variables that are taken from the state array
+  map->n_unmapped_dep = 0;
+  for (int i_dep = 0; i_dep < n_dep_var; ++i_dep)
+    if (is_set[md->dep_var_ids[i_dep]] == 0)
+      map->unmapped_dep_ids[map->n_unmapped_dep++] = i_dep;
+
+  free(solver_id);
+  free(is_set);
+  return (void *)map;
+}
+
+/** \brief Free a host state map
+ *
+ * \param host_map Pointer to the map
+ */
+void host_state_map_free(void *host_map) {
+  HostStateMap *map = (HostStateMap *)host_map;
+  if (map == NULL) return;
+  free(map->cell_offsets);
+  free(map->dep_ids);
+  free(map->dep_tracer_offsets);
+  free(map->state_ids);
+  free(map->state_tracer_offsets);
+  free(map->unmapped_dep_ids);
+  free(map);
+}
+
+/** \brief Permute the grid cells of a host state map
+ *
+ * Grid cell \c i of the permuted map is grid cell \c perm[i] of the map
+ * before the call.
+ *
+ * \param host_map Pointer to the map
+ * \param perm New order of the grid cells (0-based)
+ */
+void host_state_map_permute(void *host_map, int *perm) {
+  HostStateMap *map = (HostStateMap *)host_map;
+  long *cell_offsets = (long *)malloc(map->n_host_cells * sizeof(long));
+  if (cell_offsets == NULL) {
+    printf("\n\nERROR allocating space for host state map\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i_cell = 0; i_cell < map->n_host_cells; ++i_cell) {
+    if (perm[i_cell] < 0 || perm[i_cell] >= map->n_host_cells) {
+      printf("\n\nERROR Invalid grid cell %d in host state map permutation"
+             "\n\n",
+             perm[i_cell]);
+      exit(EXIT_FAILURE);
+    }
+    cell_offsets[i_cell] = map->cell_offsets[perm[i_cell]];
+  }
+  free(map->cell_offsets);
+  map->cell_offsets = cell_offsets;
+}
+
+/** \brief Pack tracer concentrations from a host array for the next solve
+ *
+ * Tracers mapped to solver variables are copied to the solver state vector
+ * and the rest are copied to the state array. The solver variables that are
+ * not on the host array are taken from the state array when the next call
+ * to \c solver_run() starts, so the state array can still be used to set
+ * them after packing. The next call to \c solver_run() must be made with the
+ * same state array.
+ *
+ * When fewer host grid cells than the number of grid cells being solved are
+ * packed, the remaining grid cells get the packed values of the last packed
+ * grid cell.
+ *
+ * \param solver_data Pointer to the initialized solver data
+ * \param host_map Pointer to the host state map
+ * \param first_cell Index of the host grid cell to use for the first grid
+ *                   cell being solved
+ * \param n_pack_cells Number of host grid cells to pack
+ * \param host_conc Host tracer array
+ * \param state State array
+ */
+void host_state_pack(void *solver_data, void *host_map, int first_cell,
+                     int n_pack_cells, float *host_conc, double *state) {
+#ifdef CAMP_USE_SUNDIALS
+  SolverData *sd = (SolverData *)solver_data;
+  ModelData *md = &(sd->model_data);
+  HostStateMap *map = (HostStateMap *)host_map;
+  int n_dep_var = md->n_per_cell_dep_var;
+  int n_state_var = md->n_per_cell_state_var;
+  const long *cell_offsets = &(map->cell_offsets[first_cell]);
+
+  host_state_check_cells(map, md, first_cell, n_pack_cells);
+
+  double *y = NV_DATA_S(sd->y);
+  for (int i_pair = 0; i_pair < map->n_dep; ++i_pair)
+    host_state_transpose_in(&(host_conc[map->dep_tracer_offsets[i_pair]]),
+                            cell_offsets, n_pack_cells,
+                            &(y[map->dep_ids[i_pair]]), n_dep_var,
+                            i_pair >= map->n_dep_assign);
+  for (int i_pair = 0; i_pair < map->n_state; ++i_pair)
+    host_state_transpose_in(&(host_conc[map->state_tracer_offsets[i_pair]]),
+                            cell_offsets, n_pack_cells,
+                            &(state[map->state_ids[i_pair]]), n_state_var,
+                            i_pair >= map->n_state_assign);
+
+  // Fill the remaining grid cells with the last packed grid cell
+  double *last_y = &(y[(n_pack_cells - 1) * n_dep_var]);
+  double *last_state = &(state[(n_pack_cells - 1) * n_state_var]);
+  for (int i_cell = n_pack_cells; i_cell < md->n_cells; ++i_cell) {
+    for (int i_pair = 0; i_pair < map->n_dep_assign; ++i_pair)
+      y[i_cell * n_dep_var + map->dep_ids[i_pair]] =
+          last_y[map->dep_ids[i_pair]];
+    for (int i_pair = 0; i_pair < map->n_state_assign; ++i_pair)
+      state[i_cell * n_state_var + map->state_ids[i_pair]] =
+          last_state[map->state_ids[i_pair]];
+  }
+
+  sd->host_map = map;
+#endif
+}
+
+/** \brief Unpack species concentrations to a host array after a solve
+ *
+ * Values are taken from the state array, which holds the final solver
+ * variables and any adjustments made by the sub models at the end of
+ * \c solver_run(). Species mapped to more than one tracer are copied to each
+ * tracer.
+ *
+ * \param solver_data Pointer to the initialized solver data
+ * \param host_map Pointer to the host state map
+ * \param first_cell Index of the host grid cell to use for the first grid
+ *                   cell being solved
+ * \param n_pack_cells Number of host grid cells to unpack
+ * \param state State array
+ * \param host_conc Host tracer array
+ */
+void host_state_unpack(void *solver_data, void *host_map, int first_cell,
+                       int n_pack_cells, double *state, float *host_conc) {
+  SolverData *sd = (SolverData *)solver_data;
+  ModelData *md = &(sd->model_data);
+  HostStateMap *map = (HostStateMap *)host_map;
+  int n_cells = n_pack_cells;
+  int n_state_var = md->n_per_cell_state_var;
+  const long *cell_offsets = &(map->cell_offsets[first_cell]);
+
+  host_state_check_cells(map, md, first_cell, n_pack_cells);
+
+  for (int i_pair = 0; i_pair < map->n_dep; ++i_pair)
+    host_state_transpose_out(
+        &(state[md->dep_var_ids[map->dep_ids[i_pair]]]), n_state_var,
+        cell_offsets, n_cells,
+        &(host_conc[map->dep_tracer_offsets[i_pair]]));
+  for (int i_pair = 0; i_pair < map->n_state; ++i_pair)
+    host_state_transpose_out(&(state[map->state_ids[i_pair]]), n_state_var,
+                             cell_offsets, n_cells,
+                             &(host_conc[map->state_tracer_offsets[i_pair]]));
+}
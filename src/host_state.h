@@ -0,0 +1,51 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the host-layout state functions
+ *
+ */
+/** \file
+ * \brief Header for the host-layout state functions
+ */
+#ifndef HOST_STATE_H_
+#define HOST_STATE_H_
+
+/* Map between a host model tracer array and the CAMP solver state
+ *
+ * The host array holds single-precision tracer values for a set of grid
+ * cells at arbitrary strides. Each (tracer, species) pair of the map is
+ * stored in one of two lists: pairs for solver variables, which are packed
+ * into the solver state vector, and pairs for the other state variables
+ * (constant, PSSA, ...), which are packed into the state array. Within each
+ * list the first \c n_*_assign pairs set their species and the remaining
+ * pairs (tracers mapped to a species that is already set) add to it.
+ */
+typedef struct {
+  int n_host_cells;       // Number of grid cells on the host array
+  long *cell_offsets;     // Offset of each grid cell on the host array
+  int n_dep;              // Number of pairs for solver variables
+  int n_dep_assign;       // Number of those pairs that set the variable
+  int *dep_ids;           // Solver variable id of each pair
+  long *dep_tracer_offsets;  // Offset of the tracer in a grid cell on the
+                             // host array for each pair
+  int n_state;            // Number of pairs for other state variables
+  int n_state_assign;     // Number of those pairs that set the variable
+  int *state_ids;         // State variable id of each pair
+  long *state_tracer_offsets;  // Offset of the tracer in a grid cell on the
+                               // host array for each pair
+  int n_unmapped_dep;     // Number of solver variables not on the host array
+  int *unmapped_dep_ids;  // Ids of the solver variables not on the host array
+} HostStateMap;
+
+void *host_state_map_new(void *solver_data, int n_pair, int *state_ids,
+                         long *tracer_offsets, int n_host_cells,
+                         long *cell_offsets);
+void host_state_map_free(void *host_map);
+void host_state_map_permute(void *host_map, int *perm);
+void host_state_pack(void *solver_data, void *host_map, int first_cell,
+                     int n_pack_cells, float *host_conc, double *state);
+void host_state_unpack(void *solver_data, void *host_map, int first_cell,
+                       int n_pack_cells, double *state, float *host_conc);
+
+#endif
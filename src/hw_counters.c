@@ -0,0 +1,126 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Hardware performance counter functions
+ *
+ */
+/** \file
+ * \brief Hardware performance counter functions
+ */
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "hw_counters.h"
+#include <string.h>
+
+#ifdef __linux__
+// Hardware event for each counter (the order must match HwCounterId)
+static const unsigned long long counter_events[HW_NUM_COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+// Layout of a group read with PERF_FORMAT_TOTAL_TIME_ENABLED and
+// PERF_FORMAT_TOTAL_TIME_RUNNING
+typedef struct {
+  unsigned long long nr;
+  unsigned long long time_enabled;
+  unsigned long long time_running;
+  unsigned long long values[HW_NUM_COUNTERS];
+} GroupReadFormat;
+#endif
+
+void hw_counters_initialize(HwCounters *counters) {
+  counters->group_fd = -1;
+  for (int i_counter = 0; i_counter < HW_NUM_COUNTERS; ++i_counter)
+    counters->fds[i_counter] = -1;
+  hw_counters_reset(counters);
+}
+
+int hw_counters_start(HwCounters *counters) {
+  hw_counters_free(counters);
+  hw_counters_reset(counters);
+#ifdef __linux__
+  for (int i_counter = 0; i_counter < HW_NUM_COUNTERS; ++i_counter) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = counter_events[i_counter];
+    attr.disabled = (i_counter == 0);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    counters->fds[i_counter] = (int)syscall(
+        __NR_perf_event_open, &attr, 0, -1, counters->group_fd, 0);
+    if (counters->fds[i_counter] < 0) {
+      hw_counters_free(counters);
+      return 0;
+    }
+    if (i_counter == 0) counters->group_fd = counters->fds[0];
+  }
+  if (ioctl(counters->group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) ||
+      ioctl(counters->group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP)) {
+    hw_counters_free(counters);
+    return 0;
+  }
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+void hw_counters_reset(HwCounters *counters) {
+  for (int i_count = 0; i_count < HW_NUM_REGIONS * HW_NUM_COUNTERS; ++i_count)
+    counters->counts[i_count] = 0;
+  for (int i_region = 0; i_region < HW_NUM_REGIONS; ++i_region)
+    counters->calls[i_region] = 0;
+}
+
+void hw_counters_read(HwCounters *counters, HwCounterSample *sample) {
+  sample->valid = 0;
+  if (counters->group_fd < 0) return;
+#ifdef __linux__
+  GroupReadFormat data;
+  if (read(counters->group_fd, &data, sizeof(data)) != sizeof(data)) return;
+  for (int i_counter = 0; i_counter < HW_NUM_COUNTERS; ++i_counter)
+    sample->values[i_counter] = (long long)data.values[i_counter];
+  sample->time_enabled = (long long)data.time_enabled;
+  sample->time_running = (long long)data.time_running;
+  sample->valid = 1;
+#endif
+}
+
+void hw_counters_add(HwCounters *counters, HwRegionId region_id,
+                     const HwCounterSample *start) {
+  if (counters->group_fd < 0) return;
+  HwCounterSample end;
+  hw_counters_read(counters, &end);
+  if (!start->valid || !end.valid) return;
+
+  // Scale for multiplexing of the hardware counters
+  long long enabled = end.time_enabled - start->time_enabled;
+  long long running = end.time_running - start->time_running;
+  double scale = running > 0 ? (double)enabled / (double)running : 0.0;
+
+  long long *counts = &(counters->counts[region_id * HW_NUM_COUNTERS]);
+  for (int i_counter = 0; i_counter < HW_NUM_COUNTERS; ++i_counter)
+    counts[i_counter] += (long long)(
+        scale * (double)(end.values[i_counter] - start->values[i_counter]));
+  ++(counters->calls[region_id]);
+}
+
+void hw_counters_free(HwCounters *counters) {
+#ifdef __linux__
+  for (int i_counter = HW_NUM_COUNTERS - 1; i_counter >= 0; --i_counter) {
+    if (counters->fds[i_counter] >= 0) close(counters->fds[i_counter]);
+    counters->fds[i_counter] = -1;
+  }
+#endif
+  counters->group_fd = -1;
+}
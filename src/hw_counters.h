@@ -0,0 +1,109 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the hardware performance counters and related functions
+ *
+ */
+/** \file
+ * \brief Header for the hardware performance counters and related functions
+ */
+#ifndef HW_COUNTERS_H_
+#define HW_COUNTERS_H_
+
+/* Counted hardware events (the order must match the counter index in the
+ * camp_solver_stats module) */
+typedef enum {
+  HW_COUNTER_CYCLES,         // CPU cycles
+  HW_COUNTER_INSTRUCTIONS,   // Retired instructions
+  HW_COUNTER_CACHE_MISSES,   // Last-level cache misses
+  HW_COUNTER_BRANCH_MISSES,  // Mispredicted branches
+  HW_NUM_COUNTERS
+} HwCounterId;
+
+/* Solver regions with separate counts (the order must match the region
+ * index in the camp_solver_stats module) */
+typedef enum {
+  HW_REGION_DERIV,     // Calls to f()
+  HW_REGION_JAC,       // Calls to Jac()
+  HW_REGION_LS_SETUP,  // Linear solver setup (factorization)
+  HW_REGION_LS_SOLVE,  // Linear solver solves
+  HW_NUM_REGIONS
+} HwRegionId;
+
+/* Counter values at the start of a region */
+typedef struct {
+  long long values[HW_NUM_COUNTERS];  // Raw counter values
+  long long time_enabled;             // Time the counters were enabled (ns)
+  long long time_running;             // Time the counters were counting (ns)
+  int valid;                          // Flag indicating the read succeeded
+} HwCounterSample;
+
+/* Hardware event counts accumulated for each solver region
+ *
+ * The counters are opened with perf_event_open() as one group for the
+ * calling thread, so they only count events on the thread that started
+ * them, which must be the thread that runs the solver. Counts are scaled
+ * for the time the group was actually counting when the kernel multiplexes
+ * the hardware counters. Counting is off when \c group_fd is negative.
+ */
+typedef struct {
+  int group_fd;               // File descriptor for the group leader
+  int fds[HW_NUM_COUNTERS];   // File descriptor for each counter
+  long long counts[HW_NUM_REGIONS * HW_NUM_COUNTERS];  // Accumulated counts
+                                                       // (counter varying
+                                                       // fastest)
+  long int calls[HW_NUM_REGIONS];  // Number of times each region was counted
+} HwCounters;
+
+/** \brief Initialize the hardware counters with counting turned off
+ *
+ * \param counters Pointer to the HwCounters object
+ */
+void hw_counters_initialize(HwCounters *counters);
+
+/** \brief Open and start the hardware counters for the calling thread
+ *
+ * Any accumulated counts are reset. Counting is only available on Linux and
+ * may be restricted by the \c perf_event_paranoid setting.
+ *
+ * \param counters Pointer to the HwCounters object
+ * \return Flag indicating whether counting was started (0 = false; 1 = true)
+ */
+int hw_counters_start(HwCounters *counters);
+
+/** \brief Reset the accumulated counts
+ *
+ * \param counters Pointer to the HwCounters object
+ */
+void hw_counters_reset(HwCounters *counters);
+
+/** \brief Read the current counter values at the start of a region
+ *
+ * The sample is marked as invalid if counting is off or the read fails.
+ *
+ * \param counters Pointer to the HwCounters object
+ * \param sample Sample to store the current values in
+ */
+void hw_counters_read(HwCounters *counters, HwCounterSample *sample);
+
+/** \brief Add the events counted since a start sample to a region
+ *
+ * Does nothing if counting is off or if the counters could not be read at
+ * the start or the end of the region, so failed reads are neither counted
+ * as calls nor added as (negative) event counts.
+ *
+ * \param counters Pointer to the HwCounters object
+ * \param region_id Region to add the counts to
+ * \param start Sample from \c hw_counters_read() at the start of the region
+ */
+void hw_counters_add(HwCounters *counters, HwRegionId region_id,
+                     const HwCounterSample *start);
+
+/** \brief Stop counting and close the hardware counters
+ *
+ * \param counters Pointer to the HwCounters object
+ */
+void hw_counters_free(HwCounters *counters);
+
+#endif
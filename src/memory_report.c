@@ -0,0 +1,31 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Memory footprint report functions
+ *
+ */
+/** \file
+ * \brief Memory footprint report functions
+ */
+#include "memory_report.h"
+
+void memory_report_reset(MemoryReport *report) {
+  for (int i_cat = 0; i_cat < MEM_NUM_CATEGORIES; ++i_cat) {
+    report->fixed_bytes[i_cat] = 0;
+    report->per_cell_bytes[i_cat] = 0;
+  }
+}
+
+void memory_report_add(MemoryReport *report, MemCategoryId category,
+                       long long fixed_bytes, long long per_cell_bytes) {
+  report->fixed_bytes[category] += fixed_bytes;
+  report->per_cell_bytes[category] += per_cell_bytes;
+}
+
+void memory_report_add_scaled(MemoryReport *report, MemCategoryId category,
+                              long long total_bytes, int n_cells) {
+  if (n_cells < 1) n_cells = 1;
+  report->fixed_bytes[category] += total_bytes % n_cells;
+  report->per_cell_bytes[category] += total_bytes / n_cells;
+}
@@ -0,0 +1,75 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the memory footprint report and related functions
+ *
+ */
+/** \file
+ * \brief Header for the memory footprint report and related functions
+ */
+#ifndef MEMORY_REPORT_H_
+#define MEMORY_REPORT_H_
+
+/* Memory categories (the order must match the MEM_* parameters in the
+ * camp_memory_report module) */
+typedef enum {
+  MEM_RXN_DATA,        // Reaction parameters, active reaction lists and
+                       // the rate constant table
+  MEM_AERO_DATA,       // Aerosol phase and representation parameters and
+                       // cached aerosol properties
+  MEM_SUB_MODEL_DATA,  // Sub-model parameters
+  MEM_ENV_DATA,        // Environment-dependent parameters
+  MEM_SOLVER_STATE,    // Solver and working vectors
+  MEM_JACOBIAN,        // Jacobian matrices, maps and the Jacobian structure
+  MEM_LINEAR_SOLVER,   // KLU symbolic and numeric factorizations
+  MEM_INTEGRATOR,      // CVODE integrator workspace
+  MEM_DIAGNOSTICS,     // Per-cell statistics, cost profile and event trace
+  MEM_FORTRAN_DATA,    // Model data held by the Fortran objects (only set
+                       // by the camp_core_t report)
+  MEM_NUM_CATEGORIES
+} MemCategoryId;
+
+/* Memory used by a solver, in bytes
+ *
+ * Memory is split into a part that is independent of the number of grid cells
+ * and a part that grows with each grid cell, so the total for n cells is
+ * fixed_bytes + n * per_cell_bytes.
+ */
+typedef struct {
+  long long fixed_bytes[MEM_NUM_CATEGORIES];     // Bytes independent of the
+                                                 // number of cells
+  long long per_cell_bytes[MEM_NUM_CATEGORIES];  // Bytes per grid cell
+} MemoryReport;
+
+/** \brief Reset a memory report to zero
+ *
+ * \param report Pointer to the MemoryReport object
+ */
+void memory_report_reset(MemoryReport *report);
+
+/** \brief Add memory to a category
+ *
+ * \param report Pointer to the MemoryReport object
+ * \param category Memory category
+ * \param fixed_bytes Bytes independent of the number of cells
+ * \param per_cell_bytes Bytes per grid cell
+ */
+void memory_report_add(MemoryReport *report, MemCategoryId category,
+                       long long fixed_bytes, long long per_cell_bytes);
+
+/** \brief Add memory that grows with the number of cells to a category
+ *
+ * Used for memory that is only known as a total (e.g., workspaces owned by
+ * SUNDIALS or KLU). The total is split evenly between the cells, with any
+ * remainder counted as fixed.
+ *
+ * \param report Pointer to the MemoryReport object
+ * \param category Memory category
+ * \param total_bytes Total bytes for all cells
+ * \param n_cells Number of grid cells
+ */
+void memory_report_add_scaled(MemoryReport *report, MemCategoryId category,
+                              long long total_bytes, int n_cells);
+
+#endif
@@ -11,6 +11,7 @@
 #define CAMP_DEBUG_SPEC_ 118
 
 #include "rxn_solver.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include "rxns.h"
@@ -34,6 +35,34 @@
 #define RXN_CONDENSED_PHASE_PHOTOLYSIS 18
 #define RXN_SURFACE 19
 
+// Case used in the reaction loops for reactions with compact data
+#define RXN_COMPACT_MASS_ACTION -1
+
+/** \brief Move constant reactants to the end of a reactant list
+ *
+ * Constant species do not change during solving, so reactions fold their
+ * concentrations into the rate constant when the environmental state is
+ * updated. The order of the remaining reactants is preserved.
+ *
+ * \param model_data Pointer to the model data
+ * \param react_ids Reactant state ids (starting at 1) from the reaction
+ *                  integer data
+ * \param num_react Number of reactants
+ * \return Number of constant reactants
+ */
+int rxn_sort_constant_reactants(ModelData *model_data, int *react_ids,
+                                int num_react) {
+  int num_var = 0;
+  for (int i_react = 0; i_react < num_react; i_react++) {
+    int react_id = react_ids[i_react];
+    if (model_data->var_type[react_id - 1] == CHEM_SPEC_CONSTANT) continue;
+    for (int j_react = i_react; j_react > num_var; j_react--)
+      react_ids[j_react] = react_ids[j_react - 1];
+    react_ids[num_var++] = react_id;
+  }
+  return num_react - num_var;
+}
+
 /** \brief Get the Jacobian elements used by a particular reaction
  *
  * \param model_data A pointer to the model data
@@ -62,13 +91,16 @@ void rxn_get_used_jac_elem(ModelData *model_data, Jacobian *jac) {
                                                   jac);
         break;
       case RXN_ARRHENIUS:
-        rxn_arrhenius_get_used_jac_elem(rxn_int_data, rxn_float_data, jac);
+        rxn_arrhenius_get_used_jac_elem(model_data, rxn_int_data,
+                                        rxn_float_data, jac);
         break;
       case RXN_CMAQ_H2O2:
-        rxn_CMAQ_H2O2_get_used_jac_elem(rxn_int_data, rxn_float_data, jac);
+        rxn_CMAQ_H2O2_get_used_jac_elem(model_data, rxn_int_data,
+                                        rxn_float_data, jac);
         break;
       case RXN_CMAQ_OH_HNO3:
-        rxn_CMAQ_OH_HNO3_get_used_jac_elem(rxn_int_data, rxn_float_data, jac);
+        rxn_CMAQ_OH_HNO3_get_used_jac_elem(model_data, rxn_int_data,
+                                           rxn_float_data, jac);
         break;
       case RXN_CONDENSED_PHASE_ARRHENIUS:
         rxn_condensed_phase_arrhenius_get_used_jac_elem(rxn_int_data,
@@ -90,7 +122,8 @@ void rxn_get_used_jac_elem(ModelData *model_data, Jacobian *jac) {
                                                 rxn_float_data, jac);
         break;
       case RXN_PHOTOLYSIS:
-        rxn_photolysis_get_used_jac_elem(rxn_int_data, rxn_float_data, jac);
+        rxn_photolysis_get_used_jac_elem(model_data, rxn_int_data,
+                                         rxn_float_data, jac);
         break;
       case RXN_SIMPOL_PHASE_TRANSFER:
         rxn_SIMPOL_phase_transfer_get_used_jac_elem(model_data, rxn_int_data,
@@ -101,19 +134,21 @@ void rxn_get_used_jac_elem(ModelData *model_data, Jacobian *jac) {
                                       rxn_float_data, jac);
         break;
       case RXN_TERNARY_CHEMICAL_ACTIVATION:
-        rxn_ternary_chemical_activation_get_used_jac_elem(rxn_int_data,
+        rxn_ternary_chemical_activation_get_used_jac_elem(model_data,
+                                                          rxn_int_data,
                                                           rxn_float_data, jac);
         break;
       case RXN_TROE:
-        rxn_troe_get_used_jac_elem(rxn_int_data, rxn_float_data, jac);
+        rxn_troe_get_used_jac_elem(model_data, rxn_int_data, rxn_float_data,
+                                   jac);
         break;
       case RXN_WENNBERG_NO_RO2:
         rxn_wennberg_no_ro2_get_used_jac_elem(rxn_int_data, rxn_float_data,
                                               jac);
         break;
       case RXN_WENNBERG_TUNNELING:
-        rxn_wennberg_tunneling_get_used_jac_elem(rxn_int_data, rxn_float_data,
-                                                 jac);
+        rxn_wennberg_tunneling_get_used_jac_elem(model_data, rxn_int_data,
+                                                 rxn_float_data, jac);
         break;
       case RXN_WET_DEPOSITION:
         rxn_wet_deposition_get_used_jac_elem(rxn_int_data, rxn_float_data, jac);
@@ -217,7 +252,678 @@ void rxn_update_ids(ModelData *model_data, int *deriv_ids, Jacobian jac) {
   }
 }
 
+/** \brief Get the mass-action data of a reaction
+ *
+ * \param rxn_type Reaction type
+ * \param rxn_int_data Pointer to the reaction integer data (after the type)
+ * \param rxn_float_data Pointer to the reaction floating-point data
+ * \param data Mass-action reaction data to set
+ * \return Flag indicating whether the reaction has a mass-action rate
+ */
+static bool rxn_get_mass_action_data(int rxn_type, int *rxn_int_data,
+                                     double *rxn_float_data,
+                                     RxnMassActionData *data) {
+  switch (rxn_type) {
+    case RXN_ARRHENIUS:
+      rxn_arrhenius_get_mass_action_data(rxn_int_data, rxn_float_data, data);
+      return true;
+    case RXN_CMAQ_H2O2:
+      rxn_CMAQ_H2O2_get_mass_action_data(rxn_int_data, rxn_float_data, data);
+      return true;
+    case RXN_CMAQ_OH_HNO3:
+      rxn_CMAQ_OH_HNO3_get_mass_action_data(rxn_int_data, rxn_float_data,
+                                            data);
+      return true;
+    case RXN_PHOTOLYSIS:
+      rxn_photolysis_get_mass_action_data(rxn_int_data, rxn_float_data, data);
+      return true;
+    case RXN_TERNARY_CHEMICAL_ACTIVATION:
+      rxn_ternary_chemical_activation_get_mass_action_data(
+          rxn_int_data, rxn_float_data, data);
+      return true;
+    case RXN_TROE:
+      rxn_troe_get_mass_action_data(rxn_int_data, rxn_float_data, data);
+      return true;
+    case RXN_WENNBERG_TUNNELING:
+      rxn_wennberg_tunneling_get_mass_action_data(rxn_int_data,
+                                                  rxn_float_data, data);
+      return true;
+  }
+  return false;
+}
+
+/** \brief Check that the ids of a reaction fit in the compact encoding
+ *
+ * \param data Mass-action reaction data
+ * \return Flag indicating whether all ids are below RXN_COMPACT_NO_ID
+ */
+static bool rxn_compact_ids_fit(RxnMassActionData *data) {
+  int n_dep = data->n_react + data->n_prod;
+  for (int i = 0; i < data->n_react; i++)
+    if (data->react_ids[i] - 1 >= RXN_COMPACT_NO_ID) return false;
+  for (int i = 0; i < data->n_prod; i++)
+    if (data->prod_ids[i] - 1 >= RXN_COMPACT_NO_ID) return false;
+  for (int i = 0; i < n_dep; i++)
+    if (data->deriv_ids[i] >= RXN_COMPACT_NO_ID) return false;
+  for (int i = 0; i < data->n_react * n_dep; i++)
+    if (data->jac_ids[i] >= RXN_COMPACT_NO_ID) return false;
+  return true;
+}
+
+/** \brief Get the length of the compact record of a reaction
+ *
+ * \param data Mass-action reaction data
+ * \return Number of ids in the record
+ */
+static int rxn_compact_record_size(RxnMassActionData *data) {
+  int n_dep = data->n_var_react + data->n_prod;
+  return 2 + 2 * n_dep + data->n_var_react * n_dep;
+}
+
+/** \brief Get the start of the next compact record
+ *
+ * Records that fit in a cache line are moved to the start of the next line
+ * if they would otherwise cross a line boundary.
+ *
+ * \param offset End of the previous record
+ * \param size Number of ids in the record
+ * \return Start of the record
+ */
+static int rxn_compact_record_start(int offset, int size) {
+  int line = ARENA_ALIGNMENT / sizeof(unsigned short);
+  if (size <= line && offset % line + size > line)
+    offset += line - offset % line;
+  return offset;
+}
+
+/** \brief Encode an id for the compact reaction data
+ *
+ * \param id Id (-1 for missing ids)
+ * \return Compact id
+ */
+static unsigned short rxn_compact_id(int id) {
+  return id < 0 ? RXN_COMPACT_NO_ID : (unsigned short)id;
+}
+
+/** \brief Build the compact reaction data used by the solver
+ *
+ * Must be called after the derivative and Jacobian ids of the reactions are
+ * set. The reaction integer and floating-point data remain unchanged and are
+ * used for reactions that are not encoded.
+ *
+ * \param model_data Pointer to the model data
+ */
+void rxn_build_compact_data(ModelData *model_data) {
+  RxnCompactData *compact = &(model_data->rxn_compact);
+  Arena *arena = &(model_data->arena);
+  int n_rxn = model_data->n_rxn;
+  RxnMassActionData data;
+
+  compact->n_rxn = 0;
+  compact->n_ids = 0;
+  compact->n_yields = 0;
+  compact->rxn_offsets = (int *)arena_alloc(arena, (n_rxn + 1) * sizeof(int));
+  compact->yield_offsets =
+      (int *)arena_alloc(arena, (n_rxn + 1) * sizeof(int));
+  if (compact->rxn_offsets == NULL || compact->yield_offsets == NULL) {
+    printf("\n\nERROR allocating space for the compact reaction data\n\n");
+    exit(EXIT_FAILURE);
+  }
+
+  // Find the reactions to encode and lay out their records
+  int n_encoded = 0;
+  for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
+    int *rxn_int_data =
+        &(model_data->rxn_int_data[model_data->rxn_int_indices[i_rxn]]);
+    double *rxn_float_data =
+        &(model_data->rxn_float_data[model_data->rxn_float_indices[i_rxn]]);
+    int rxn_type = *(rxn_int_data++);
+
+    compact->rxn_offsets[i_rxn] = -1;
+    compact->yield_offsets[i_rxn] = -1;
+    if (!rxn_get_mass_action_data(rxn_type, rxn_int_data, rxn_float_data,
+                                  &data) ||
+        !rxn_compact_ids_fit(&data))
+      continue;
+    int size = rxn_compact_record_size(&data);
+    compact->n_ids = rxn_compact_record_start(compact->n_ids, size);
+    compact->rxn_offsets[i_rxn] = compact->n_ids;
+    compact->yield_offsets[i_rxn] = compact->n_yields;
+    compact->n_ids += size;
+    compact->n_yields += data.n_prod;
+    n_encoded++;
+  }
+  if (n_encoded == 0) return;
+
+  compact->ids = (unsigned short *)arena_alloc(
+      arena, compact->n_ids * sizeof(unsigned short));
+  compact->yields =
+      (double *)arena_alloc(arena, (compact->n_yields + 1) * sizeof(double));
+  if (compact->ids == NULL || compact->yields == NULL) {
+    printf("\n\nERROR allocating space for the compact reaction data\n\n");
+    exit(EXIT_FAILURE);
+  }
+
+  // Fill the records
+  for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
+    if (compact->rxn_offsets[i_rxn] < 0) continue;
+    int *rxn_int_data =
+        &(model_data->rxn_int_data[model_data->rxn_int_indices[i_rxn]]);
+    double *rxn_float_data =
+        &(model_data->rxn_float_data[model_data->rxn_float_indices[i_rxn]]);
+    int rxn_type = *(rxn_int_data++);
+    rxn_get_mass_action_data(rxn_type, rxn_int_data, rxn_float_data, &data);
+
+    int n_dep = data.n_react + data.n_prod;
+    unsigned short *ids = &(compact->ids[compact->rxn_offsets[i_rxn]]);
+    *(ids++) = (unsigned short)data.n_var_react;
+    *(ids++) = (unsigned short)data.n_prod;
+    for (int i = 0; i < data.n_var_react; i++)
+      *(ids++) = (unsigned short)(data.react_ids[i] - 1);
+    for (int i = 0; i < data.n_prod; i++)
+      *(ids++) = (unsigned short)(data.prod_ids[i] - 1);
+    for (int i = 0; i < data.n_var_react; i++)
+      *(ids++) = rxn_compact_id(data.deriv_ids[i]);
+    for (int i = 0; i < data.n_prod; i++)
+      *(ids++) = rxn_compact_id(data.deriv_ids[data.n_react + i]);
+    for (int i_ind = 0; i_ind < data.n_var_react; i_ind++) {
+      for (int i_dep = 0; i_dep < data.n_var_react; i_dep++)
+        *(ids++) = rxn_compact_id(data.jac_ids[i_ind * n_dep + i_dep]);
+      for (int i_dep = 0; i_dep < data.n_prod; i_dep++)
+        *(ids++) =
+            rxn_compact_id(data.jac_ids[i_ind * n_dep + data.n_react + i_dep]);
+    }
+    for (int i = 0; i < data.n_prod; i++)
+      compact->yields[compact->yield_offsets[i_rxn] + i] = data.yields[i];
+  }
+  compact->n_rxn = n_encoded;
+}
+
+/** \brief Get the compact record of a reaction
+ *
+ * \param model_data Pointer to the model data
+ * \param i_rxn Index of the reaction
+ * \param yields Set to the product yields of the reaction
+ * \return Pointer to the record, or NULL if the reaction is not encoded
+ */
+static inline const unsigned short *rxn_compact_record(ModelData *model_data,
+                                                       int i_rxn,
+                                                       const double **yields) {
+  RxnCompactData *compact = &(model_data->rxn_compact);
+  if (compact->n_rxn == 0 || compact->rxn_offsets[i_rxn] < 0) return NULL;
+  *yields = &(compact->yields[compact->yield_offsets[i_rxn]]);
+  return &(compact->ids[compact->rxn_offsets[i_rxn]]);
+}
+
+#ifdef CAMP_USE_SUNDIALS
+/** \brief Calculate the time derivative contributions of a reaction from its
+ * compact record
+ *
+ * Equivalent to the calc_deriv_contrib functions of the mass-action reaction
+ * types.
+ *
+ * \param model_data Pointer to the model data
+ * \param time_deriv TimeDerivative object
+ * \param ids Compact record of the reaction
+ * \param yields Product yields
+ * \param rxn_env_data Pointer to the environment-dependent parameters
+ * \param time_step Current time step being computed (s)
+ */
+static void rxn_compact_calc_deriv_contrib(ModelData *model_data,
+                                           TimeDerivative time_deriv,
+                                           const unsigned short *ids,
+                                           const double *yields,
+                                           double *rxn_env_data,
+                                           double time_step) {
+  int n_var_react = ids[0];
+  int n_prod = ids[1];
+  const unsigned short *react = &(ids[2]);
+  const unsigned short *prod = &(react[n_var_react]);
+  const unsigned short *deriv = &(prod[n_prod]);
+  double *state = model_data->grid_cell_state;
+
+  // Calculate the reaction rate
+  long double rate = rxn_env_data[0];
+  for (int i_spec = 0; i_spec < n_var_react; i_spec++)
+    rate *= state[react[i_spec]];
+  if (rate == ZERO) return;
+
+  // Add contributions to the time derivative
+  for (int i_spec = 0; i_spec < n_var_react; i_spec++) {
+    if (deriv[i_spec] == RXN_COMPACT_NO_ID) continue;
+    time_derivative_add_value(time_deriv, deriv[i_spec], -rate);
+  }
+  deriv = &(deriv[n_var_react]);
+  for (int i_spec = 0; i_spec < n_prod; i_spec++) {
+    if (deriv[i_spec] == RXN_COMPACT_NO_ID) continue;
+
+    // Negative yields are allowed, but prevented from causing negative
+    // concentrations that lead to solver failures
+    if (-rate * yields[i_spec] * time_step <= state[prod[i_spec]]) {
+      time_derivative_add_value(time_deriv, deriv[i_spec],
+                                rate * yields[i_spec]);
+    }
+  }
+}
+
+/** \brief Calculate the Jacobian contributions of a reaction from its compact
+ * record
+ *
+ * Equivalent to the calc_jac_contrib functions of the mass-action reaction
+ * types.
+ *
+ * \param model_data Pointer to the model data
+ * \param jac Reaction Jacobian
+ * \param ids Compact record of the reaction
+ * \param yields Product yields
+ * \param rxn_env_data Pointer to the environment-dependent parameters
+ * \param time_step Current time step being calculated (s)
+ */
+static void rxn_compact_calc_jac_contrib(ModelData *model_data, Jacobian jac,
+                                         const unsigned short *ids,
+                                         const double *yields,
+                                         double *rxn_env_data,
+                                         double time_step) {
+  int n_var_react = ids[0];
+  int n_prod = ids[1];
+  const unsigned short *react = &(ids[2]);
+  const unsigned short *prod = &(react[n_var_react]);
+  const unsigned short *jac_id = &(prod[n_prod + n_var_react + n_prod]);
+  double *state = model_data->grid_cell_state;
+
+  // Add contributions to the Jacobian
+  for (int i_ind = 0; i_ind < n_var_react; i_ind++) {
+    // Calculate d_rate / d_i_ind
+    realtype rate = rxn_env_data[0];
+    for (int i_spec = 0; i_spec < n_var_react; i_spec++)
+      if (i_spec != i_ind) rate *= state[react[i_spec]];
+
+    for (int i_dep = 0; i_dep < n_var_react; i_dep++, jac_id++) {
+      if (*jac_id == RXN_COMPACT_NO_ID) continue;
+      jacobian_add_value(jac, *jac_id, JACOBIAN_LOSS, rate);
+    }
+    for (int i_dep = 0; i_dep < n_prod; i_dep++, jac_id++) {
+      if (*jac_id == RXN_COMPACT_NO_ID) continue;
+      // Negative yields are allowed, but prevented from causing negative
+      // concentrations that lead to solver failures
+      if (-rate * state[react[i_ind]] * yields[i_dep] * time_step <=
+          state[prod[i_dep]]) {
+        jacobian_add_value(jac, *jac_id, JACOBIAN_PRODUCTION,
+                           yields[i_dep] * rate);
+      }
+    }
+  }
+}
+#endif
+
+/** \brief Calculate the tabulatable rate constants of a reaction
+ *
+ * \param rxn_type Reaction type
+ * \param rxn_int_data Pointer to the reaction integer data (after the type)
+ * \param rxn_float_data Pointer to the reaction floating-point data
+ * \param env_data Pointer to the environmental state array
+ * \param rxn_env_data Pointer to the environment-dependent parameters
+ * \return Number of rate constants calculated (0 for reaction types whose
+ *         rate constants cannot be tabulated)
+ */
+static int rxn_calc_rate_constants(int rxn_type, int *rxn_int_data,
+                                   double *rxn_float_data, double *env_data,
+                                   double *rxn_env_data) {
+  switch (rxn_type) {
+    case RXN_ARRHENIUS:
+      rxn_arrhenius_calc_rate_constants(rxn_int_data, rxn_float_data, env_data,
+                                        rxn_env_data);
+      return 1;
+    case RXN_CMAQ_H2O2:
+      rxn_CMAQ_H2O2_calc_rate_constants(rxn_int_data, rxn_float_data, env_data,
+                                        rxn_env_data);
+      return 1;
+    case RXN_CMAQ_OH_HNO3:
+      rxn_CMAQ_OH_HNO3_calc_rate_constants(rxn_int_data, rxn_float_data,
+                                           env_data, rxn_env_data);
+      return 1;
+    case RXN_TERNARY_CHEMICAL_ACTIVATION:
+      rxn_ternary_chemical_activation_calc_rate_constants(
+          rxn_int_data, rxn_float_data, env_data, rxn_env_data);
+      return 1;
+    case RXN_TROE:
+      rxn_troe_calc_rate_constants(rxn_int_data, rxn_float_data, env_data,
+                                   rxn_env_data);
+      return 1;
+    case RXN_WENNBERG_NO_RO2:
+      rxn_wennberg_no_ro2_calc_rate_constants(rxn_int_data, rxn_float_data,
+                                              env_data, rxn_env_data);
+      return 2;
+    case RXN_WENNBERG_TUNNELING:
+      rxn_wennberg_tunneling_calc_rate_constants(rxn_int_data, rxn_float_data,
+                                                 env_data, rxn_env_data);
+      return 1;
+  }
+  return 0;
+}
+
+/** \brief Get the log of the interpolated rate constants at a fractional
+ *         position in the rate constant table
+ *
+ * \param table Pointer to the rate constant table
+ * \param stride Number of values stored at each table node
+ * \param i_value Index of the value at each table node
+ * \param x_temp Fractional temperature node index
+ * \param x_press Fractional log pressure node index
+ * \return Interpolated log value
+ */
+static double rxn_rate_table_interp_log(RateTable *table, int stride,
+                                        int i_value, double x_temp,
+                                        double x_press) {
+  int i_temp = (int)x_temp;
+  int i_press = (int)x_press;
+  if (i_temp > table->n_temp - 2) i_temp = table->n_temp - 2;
+  if (i_press > table->n_press - 2) i_press = table->n_press - 2;
+  double w_temp = x_temp - i_temp;
+  double w_press = x_press - i_press;
+  double *v00 =
+      &(table->log_values[(i_temp * table->n_press + i_press) * stride]);
+  double *v01 = v00 + stride;
+  double *v10 = v00 + table->n_press * stride;
+  double *v11 = v10 + stride;
+  return (1.0 - w_temp) *
+             ((1.0 - w_press) * v00[i_value] + w_press * v01[i_value]) +
+         w_temp * ((1.0 - w_press) * v10[i_value] + w_press * v11[i_value]);
+}
+
+/** \brief Build the rate constant lookup table
+ *
+ * Rate constants of the temperature- and pressure-dependent gas-phase
+ * reactions are evaluated at the nodes of the (T, log P) grid set with
+ * \c solver_set_rate_table() and interpolated bilinearly in log space during
+ * solving. The interpolation error for each reaction is checked against the
+ * analytic rate constants at the midpoints between table nodes, and reactions
+ * whose error exceeds the table tolerance continue to use the analytic form.
+ *
+ * \param model_data Pointer to the model data
+ */
+void rxn_build_rate_table(ModelData *model_data) {
+  RateTable *table = &(model_data->rate_table);
+  if (table->n_temp < 2 || table->n_press < 2) return;
+
+  int n_rxn = model_data->n_rxn;
+  int n_temp = table->n_temp;
+  int n_press = table->n_press;
+  int n_nodes = n_temp * n_press;
+  table->d_temp = (table->temp_max__K - table->temp_min__K) / (n_temp - 1);
+  table->d_log_press =
+      (table->log_press_max - table->log_press_min) / (n_press - 1);
+
+  // Working arrays
+  double env_data[CAMP_NUM_ENV_PARAM_];
+  double *rxn_env_data =
+      (double *)calloc(model_data->n_rxn_env_data + 1, sizeof(double));
+  int *first_value = (int *)malloc((n_rxn + 1) * sizeof(int));
+  int *num_values = (int *)calloc(n_rxn + 1, sizeof(int));
+  if (rxn_env_data == NULL || first_value == NULL || num_values == NULL) {
+    printf("\n\nERROR allocating space for the rate constant table\n\n");
+    exit(EXIT_FAILURE);
+  }
+
+  // Find the reactions with rate constants that can be tabulated
+  env_data[0] = table->temp_min__K;
+  env_data[1] = exp(table->log_press_min);
+  int n_candidates = 0;
+  for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
+    int *rxn_int_data =
+        &(model_data->rxn_int_data[model_data->rxn_int_indices[i_rxn]]);
+    double *rxn_float_data =
+        &(model_data->rxn_float_data[model_data->rxn_float_indices[i_rxn]]);
+    int rxn_type = *(rxn_int_data++);
+    first_value[i_rxn] = n_candidates;
+    num_values[i_rxn] = rxn_calc_rate_constants(
+        rxn_type, rxn_int_data, rxn_float_data, env_data,
+        &(rxn_env_data[model_data->rxn_env_idx[i_rxn]]));
+    n_candidates += num_values[i_rxn];
+  }
+  if (n_candidates == 0) {
+    free(rxn_env_data);
+    free(first_value);
+    free(num_values);
+    return;
+  }
+
+  // Evaluate the rate constants at the table nodes
+  double *log_values =
+      (double *)malloc(n_nodes * n_candidates * sizeof(double));
+  if (log_values == NULL) {
+    printf("\n\nERROR allocating space for the rate constant table\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i_temp = 0; i_temp < n_temp; i_temp++) {
+    for (int i_press = 0; i_press < n_press; i_press++) {
+      double *node_values =
+          &(log_values[(i_temp * n_press + i_press) * n_candidates]);
+      env_data[0] = table->temp_min__K + i_temp * table->d_temp;
+      env_data[1] = exp(table->log_press_min + i_press * table->d_log_press);
+      for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
+        if (num_values[i_rxn] == 0) continue;
+        int *rxn_int_data =
+            &(model_data->rxn_int_data[model_data->rxn_int_indices[i_rxn]]);
+        double *rxn_float_data = &(
+            model_data->rxn_float_data[model_data->rxn_float_indices[i_rxn]]);
+        double *rate_consts = &(rxn_env_data[model_data->rxn_env_idx[i_rxn]]);
+        int rxn_type = *(rxn_int_data++);
+        rxn_calc_rate_constants(rxn_type, rxn_int_data, rxn_float_data,
+                                env_data, rate_consts);
+        for (int i_val = 0; i_val < num_values[i_rxn]; i_val++) {
+          // Rate constants must be positive to be interpolated in log space
+          if (!(rate_consts[i_val] > 0.0) || !isfinite(rate_consts[i_val])) {
+            num_values[i_rxn] = 0;
+            break;
+          }
+          node_values[first_value[i_rxn] + i_val] = log(rate_consts[i_val]);
+        }
+      }
+    }
+  }
+
+  // Check the interpolation error against the analytic rate constants at
+  // the midpoints between nodes
+  RateTable check_table = *table;
+  check_table.log_values = log_values;
+  double max_rel_error = 0.0;
+  for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
+    if (num_values[i_rxn] == 0) continue;
+    int *rxn_int_data =
+        &(model_data->rxn_int_data[model_data->rxn_int_indices[i_rxn]]);
+    double *rxn_float_data =
+        &(model_data->rxn_float_data[model_data->rxn_float_indices[i_rxn]]);
+    double *rate_consts = &(rxn_env_data[model_data->rxn_env_idx[i_rxn]]);
+    int rxn_type = *(rxn_int_data++);
+    double rxn_max_error = 0.0;
+    for (int i_temp = 0; i_temp < 2 * n_temp - 1; i_temp++) {
+      for (int i_press = 0; i_press < 2 * n_press - 1; i_press++) {
+        if (i_temp % 2 == 0 && i_press % 2 == 0) continue;
+        double x_temp = 0.5 * i_temp;
+        double x_press = 0.5 * i_press;
+        env_data[0] = table->temp_min__K + x_temp * table->d_temp;
+        env_data[1] = exp(table->log_press_min + x_press * table->d_log_press);
+        rxn_calc_rate_constants(rxn_type, rxn_int_data, rxn_float_data,
+                                env_data, rate_consts);
+        for (int i_val = 0; i_val < num_values[i_rxn]; i_val++) {
+          double interp = exp(rxn_rate_table_interp_log(
+              &check_table, n_candidates, first_value[i_rxn] + i_val, x_temp,
+              x_press));
+          double rel_error =
+              fabs(interp - rate_consts[i_val]) / rate_consts[i_val];
+          if (!(rel_error <= rxn_max_error)) rxn_max_error = rel_error;
+        }
+      }
+    }
+    if (!(rxn_max_error <= table->tolerance)) {
+      num_values[i_rxn] = 0;
+    } else if (rxn_max_error > max_rel_error) {
+      max_rel_error = rxn_max_error;
+    }
+  }
+
+  // Keep only the values for reactions that passed the error check
+  table->n_rxn = 0;
+  table->n_values = 0;
+  table->max_rel_error = max_rel_error;
+  table->env_value_idx =
+      (int *)malloc((model_data->n_rxn_env_data + 1) * sizeof(int));
+  if (table->env_value_idx == NULL) {
+    printf("\n\nERROR allocating space for the rate constant table\n\n");
+    exit(EXIT_FAILURE);
+  }
+  for (int i_env = 0; i_env < model_data->n_rxn_env_data; i_env++)
+    table->env_value_idx[i_env] = -1;
+  for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
+    if (num_values[i_rxn] == 0) continue;
+    for (int i_val = 0; i_val < num_values[i_rxn]; i_val++)
+      table->env_value_idx[model_data->rxn_env_idx[i_rxn] + i_val] =
+          table->n_values + i_val;
+    for (int i_node = 0; i_node < n_nodes; i_node++)
+      for (int i_val = 0; i_val < num_values[i_rxn]; i_val++)
+        log_values[i_node * n_candidates + table->n_values + i_val] =
+            log_values[i_node * n_candidates + first_value[i_rxn] + i_val];
+    table->n_values += num_values[i_rxn];
+    ++(table->n_rxn);
+  }
+  if (table->n_values > 0) {
+    for (int i_node = 0; i_node < n_nodes; i_node++)
+      for (int i_val = 0; i_val < table->n_values; i_val++)
+        log_values[i_node * table->n_values + i_val] =
+            log_values[i_node * n_candidates + i_val];
+    table->log_values = log_values;
+    table->cell_values = (double *)malloc(table->n_values * sizeof(double));
+    if (table->cell_values == NULL) {
+      printf("\n\nERROR allocating space for the rate constant table\n\n");
+      exit(EXIT_FAILURE);
+    }
+  } else {
+    free(log_values);
+    free(table->env_value_idx);
+    table->env_value_idx = NULL;
+  }
+  table->cell_in_range = false;
+
+  free(rxn_env_data);
+  free(first_value);
+  free(num_values);
+}
+
+/** \brief Interpolate the tabulated rate constants for the current grid cell
+ *
+ * \param model_data Pointer to the model data with the updated env state
+ */
+static void rxn_rate_table_set_cell(ModelData *model_data) {
+  RateTable *table = &(model_data->rate_table);
+  double temp = model_data->grid_cell_env[0];
+  double log_press = log(model_data->grid_cell_env[1]);
+
+  // Use the analytic rate constants outside the tabulated range
+  table->cell_in_range =
+      temp >= table->temp_min__K && temp <= table->temp_max__K &&
+      log_press >= table->log_press_min && log_press <= table->log_press_max;
+  if (!table->cell_in_range) return;
+
+  double x_temp = (temp - table->temp_min__K) / table->d_temp;
+  double x_press = (log_press - table->log_press_min) / table->d_log_press;
+  int i_temp = (int)x_temp;
+  int i_press = (int)x_press;
+  if (i_temp > table->n_temp - 2) i_temp = table->n_temp - 2;
+  if (i_press > table->n_press - 2) i_press = table->n_press - 2;
+  double w_temp = x_temp - i_temp;
+  double w_press = x_press - i_press;
+  double w00 = (1.0 - w_temp) * (1.0 - w_press);
+  double w01 = (1.0 - w_temp) * w_press;
+  double w10 = w_temp * (1.0 - w_press);
+  double w11 = w_temp * w_press;
+
+  // The weights are shared by all tabulated values, so this loop vectorizes
+  int n_values = table->n_values;
+  const double *v00 =
+      &(table->log_values[(i_temp * table->n_press + i_press) * n_values]);
+  const double *v01 = v00 + n_values;
+  const double *v10 = v00 + table->n_press * n_values;
+  const double *v11 = v10 + n_values;
+  double *cell_values = table->cell_values;
+  for (int i_val = 0; i_val < n_values; i_val++)
+    cell_values[i_val] = exp(w00 * v00[i_val] + w01 * v01[i_val] +
+                             w10 * v10[i_val] + w11 * v11[i_val]);
+}
+
+/** \brief Get tabulated rate constants for the current grid cell
+ *
+ * \param model_data Pointer to the model data
+ * \param rxn_env_data Pointer to the environment-dependent parameters of the
+ *                     reaction in the current grid cell
+ * \param num_values Number of rate constants to set
+ * \return Flag indicating whether the rate constants were set from the table
+ */
+bool rxn_rate_table_get_values(ModelData *model_data, double *rxn_env_data,
+                               int num_values) {
+  RateTable *table = &(model_data->rate_table);
+  if (table->n_values == 0 || !table->cell_in_range) return false;
+  int i_value =
+      table->env_value_idx[rxn_env_data - model_data->grid_cell_rxn_env_data];
+  if (i_value < 0) return false;
+  for (int i_val = 0; i_val < num_values; i_val++)
+    rxn_env_data[i_val] = table->cell_values[i_value + i_val];
+  return true;
+}
+
+/** \brief Free the rate constant lookup table
+ *
+ * \param model_data Pointer to the model data
+ */
+void rxn_free_rate_table(ModelData *model_data) {
+  RateTable *table = &(model_data->rate_table);
+  free(table->env_value_idx);
+  free(table->log_values);
+  free(table->cell_values);
+  table->env_value_idx = NULL;
+  table->log_values = NULL;
+  table->cell_values = NULL;
+  table->n_values = 0;
+  table->n_rxn = 0;
+}
+
+/** \brief Check whether a reaction makes any contributions for the current
+ *         environmental state
+ *
+ * Contributions from these reaction types are proportional to their rate
+ * constants (or rates), so they can be skipped when the rate constants are
+ * zero, as for photolysis at night or emissions that are turned off.
+ *
+ * \param rxn_type Reaction type
+ * \param rxn_env_data Pointer to the environment-dependent parameters
+ * \return Flag indicating whether the reaction must be included in the
+ *         derivative and Jacobian calculations
+ */
+static bool rxn_is_active(int rxn_type, double *rxn_env_data) {
+  switch (rxn_type) {
+    case RXN_ARRHENIUS:
+    case RXN_CMAQ_H2O2:
+    case RXN_CMAQ_OH_HNO3:
+    case RXN_CONDENSED_PHASE_ARRHENIUS:
+    case RXN_CONDENSED_PHASE_PHOTOLYSIS:
+    case RXN_EMISSION:
+    case RXN_FIRST_ORDER_LOSS:
+    case RXN_PHOTOLYSIS:
+    case RXN_TERNARY_CHEMICAL_ACTIVATION:
+    case RXN_TROE:
+    case RXN_WENNBERG_TUNNELING:
+    case RXN_WET_DEPOSITION:
+      return rxn_env_data[0] != 0.0;
+    case RXN_WENNBERG_NO_RO2:
+      return rxn_env_data[0] != 0.0 || rxn_env_data[1] != 0.0;
+  }
+  return true;
+}
+
 /** \brief Update reaction data for new environmental state
+ *
+ * Also builds the list of reactions that contribute to the derivative and
+ * Jacobian in the current grid cell.
  *
  * \param model_data Pointer to the model data with updated env state
  */
@@ -225,6 +931,14 @@ void rxn_update_env_state(ModelData *model_data) {
   // Get the number of reactions
   int n_rxn = model_data->n_rxn;
 
+  // Get the list of active reactions for this grid cell
+  int *active_ids =
+      &(model_data->rxn_active_ids[model_data->grid_cell_id * n_rxn]);
+  int n_active = 0;
+
+  // Interpolate the tabulated rate constants for this grid cell
+  if (model_data->rate_table.n_values > 0) rxn_rate_table_set_cell(model_data);
+
   // Loop through the reactions advancing the rxn_data pointer each time
   for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
     // Get pointers to the reaction data
@@ -309,7 +1023,11 @@ void rxn_update_env_state(ModelData *model_data) {
                                             rxn_float_data, rxn_env_data);
         break;
     }
+
+    // Skip reactions with zero rate constants during solving
+    if (rxn_is_active(rxn_type, rxn_env_data)) active_ids[n_active++] = i_rxn;
   }
+  model_data->n_active_rxn[model_data->grid_cell_id] = n_active;
 }
 
 /** \brief Calculate the time derivative \f$f(t,y)\f$
@@ -321,11 +1039,18 @@ void rxn_update_env_state(ModelData *model_data) {
 #ifdef CAMP_USE_SUNDIALS
 void rxn_calc_deriv(ModelData *model_data, TimeDerivative time_deriv,
                     realtype time_step) {
-  // Get the number of reactions
-  int n_rxn = model_data->n_rxn;
+  // Get the reactions that are active in the current grid cell
+  int *active_ids = &(model_data->rxn_active_ids[model_data->grid_cell_id *
+                                                 model_data->n_rxn]);
+  int n_active = model_data->n_active_rxn[model_data->grid_cell_id];
+  CostProfile *profile = &(model_data->cost_profile);
+  double start__s =
+      profile->level != COST_PROFILE_OFF ? solver_timer_now() : 0.0;
+
+  // Loop through the active reactions
+  for (int i_active = 0; i_active < n_active; i_active++) {
+    int i_rxn = active_ids[i_active];
 
-  // Loop through the reactions advancing the rxn_data pointer each time
-  for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
     // Get pointers to the reaction data
     int *rxn_int_data =
         &(model_data->rxn_int_data[model_data->rxn_int_indices[i_rxn]]);
@@ -334,11 +1059,17 @@ void rxn_calc_deriv(ModelData *model_data, TimeDerivative time_deriv,
     double *rxn_env_data =
         &(model_data->grid_cell_rxn_env_data[model_data->rxn_env_idx[i_rxn]]);
 
-    // Get the reaction type
+    // Get the reaction type and compact data
     int rxn_type = *(rxn_int_data++);
+    const double *yields;
+    const unsigned short *ids = rxn_compact_record(model_data, i_rxn, &yields);
 
     // Call the appropriate function
-    switch (rxn_type) {
+    switch (ids != NULL ? RXN_COMPACT_MASS_ACTION : rxn_type) {
+      case RXN_COMPACT_MASS_ACTION:
+        rxn_compact_calc_deriv_contrib(model_data, time_deriv, ids, yields,
+                                       rxn_env_data, time_step);
+        break;
       case RXN_AQUEOUS_EQUILIBRIUM:
         rxn_aqueous_equilibrium_calc_deriv_contrib(model_data, time_deriv,
                                                    rxn_int_data, rxn_float_data,
@@ -424,6 +1155,9 @@ void rxn_calc_deriv(ModelData *model_data, TimeDerivative time_deriv,
                                               rxn_env_data, time_step);
         break;
     }
+    if (profile->level != COST_PROFILE_OFF)
+      start__s = cost_profile_add_rxn(profile, COST_PROFILE_DERIV, rxn_type,
+                                      i_rxn, start__s);
   }
 }
 #endif
@@ -480,11 +1214,18 @@ void rxn_calc_deriv_specific_types(ModelData *model_data,
  */
 #ifdef CAMP_USE_SUNDIALS
 void rxn_calc_jac(ModelData *model_data, Jacobian jac, realtype time_step) {
-  // Get the number of reactions
-  int n_rxn = model_data->n_rxn;
+  // Get the reactions that are active in the current grid cell
+  int *active_ids = &(model_data->rxn_active_ids[model_data->grid_cell_id *
+                                                 model_data->n_rxn]);
+  int n_active = model_data->n_active_rxn[model_data->grid_cell_id];
+  CostProfile *profile = &(model_data->cost_profile);
+  double start__s =
+      profile->level != COST_PROFILE_OFF ? solver_timer_now() : 0.0;
+
+  // Loop through the active reactions
+  for (int i_active = 0; i_active < n_active; i_active++) {
+    int i_rxn = active_ids[i_active];
 
-  // Loop through the reactions advancing the rxn_data pointer each time
-  for (int i_rxn = 0; i_rxn < n_rxn; i_rxn++) {
     // Get pointers to the reaction data
     int *rxn_int_data =
         &(model_data->rxn_int_data[model_data->rxn_int_indices[i_rxn]]);
@@ -493,11 +1234,17 @@ void rxn_calc_jac(ModelData *model_data, Jacobian jac, realtype time_step) {
     double *rxn_env_data =
         &(model_data->grid_cell_rxn_env_data[model_data->rxn_env_idx[i_rxn]]);
 
-    // Get the reaction type
+    // Get the reaction type and compact data
     int rxn_type = *(rxn_int_data++);
+    const double *yields;
+    const unsigned short *ids = rxn_compact_record(model_data, i_rxn, &yields);
 
     // Call the appropriate function
-    switch (rxn_type) {
+    switch (ids != NULL ? RXN_COMPACT_MASS_ACTION : rxn_type) {
+      case RXN_COMPACT_MASS_ACTION:
+        rxn_compact_calc_jac_contrib(model_data, jac, ids, yields,
+                                     rxn_env_data, time_step);
+        break;
       case RXN_AQUEOUS_EQUILIBRIUM:
         rxn_aqueous_equilibrium_calc_jac_contrib(model_data, jac, rxn_int_data,
                                                  rxn_float_data, rxn_env_data,
@@ -580,6 +1327,9 @@ void rxn_calc_jac(ModelData *model_data, Jacobian jac, realtype time_step) {
                                             time_step);
         break;
     }
+    if (profile->level != COST_PROFILE_OFF)
+      start__s = cost_profile_add_rxn(profile, COST_PROFILE_JAC, rxn_type,
+                                      i_rxn, start__s);
   }
 }
 #endif
@@ -709,10 +1459,15 @@ void rxn_update_data(int cell_id, int *rxn_id, int update_rxn_type,
                      void *update_data, void *solver_data) {
   ModelData *model_data =
       (ModelData *)&(((SolverData *)solver_data)->model_data);
+  SolverTrace *trace = &(((SolverData *)solver_data)->trace);
+  double start__s = trace->events != NULL ? solver_timer_now() : 0.0;
+
+  // The environment-dependent data of the grid cell must be recalculated
+  model_data->env_cache[cell_id * model_data->n_env_cache] = NAN;
 
   // Point to the environment-dependent data for the grid cell
   model_data->grid_cell_rxn_env_data =
-      &(model_data->rxn_env_data[cell_id * model_data->n_rxn_env_data]);
+      &(model_data->rxn_env_data[cell_id * model_data->n_cell_env_data]);
 
   // Get the number of reactions
   int n_rxn = model_data->n_rxn;
@@ -757,9 +1512,12 @@ void rxn_update_data(int cell_id, int *rxn_id, int update_rxn_type,
               (void *)update_data, rxn_int_data, rxn_float_data, rxn_env_data);
           break;
       }
-      if (found) return;
+      if (found) break;
     }
   }
+  if (trace->events != NULL)
+    solver_trace_add(trace, SOLVER_TRACE_RXN_UPDATE_DATA, start__s,
+                     solver_timer_now());
 }
 
 /** \brief Print the reaction data
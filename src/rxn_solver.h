@@ -18,7 +18,10 @@
 /* Solver functions */
 void rxn_get_used_jac_elem(ModelData *model_data, Jacobian *jac);
 void rxn_update_ids(ModelData *model_data, int *deriv_ids, Jacobian jac);
+void rxn_build_compact_data(ModelData *model_data);
 void rxn_update_env_state(ModelData *model_data);
+void rxn_build_rate_table(ModelData *model_data);
+void rxn_free_rate_table(ModelData *model_data);
 void rxn_reset_state_adjustments(ModelData *model_data);
 void rxn_adjust_state(ModelData *model_data);
 void rxn_print_data(void *solver_data);
@@ -16,6 +16,26 @@
 #include "Jacobian.h"
 #include "camp_common.h"
 
+/* Reactant, product and index data of a reaction with a mass-action rate
+ * (pointers are into the reaction data, with 1-based state ids) */
+typedef struct {
+  int n_react;      // number of reactants
+  int n_var_react;  // number of reactants that are not constant
+  int n_prod;       // number of products
+  int *react_ids;   // reactant state ids (constant reactants last)
+  int *prod_ids;    // product state ids
+  int *deriv_ids;   // derivative ids of the reactants then the products
+  int *jac_ids;     // Jacobian ids for each reactant (independent) and each
+                    // reactant then product (dependent)
+  double *yields;   // product yields
+} RxnMassActionData;
+
+// Shared reaction functions
+int rxn_sort_constant_reactants(ModelData *model_data, int *react_ids,
+                                int num_react);
+bool rxn_rate_table_get_values(ModelData *model_data, double *rxn_env_data,
+                               int num_values);
+
 // aqueous_equilibrium
 void rxn_aqueous_equilibrium_get_used_jac_elem(int *rxn_int_data,
                                                double *rxn_float_data,
@@ -40,14 +60,20 @@ void rxn_aqueous_equilibrium_calc_jac_contrib(ModelData *model_data,
 #endif
 
 // arrhenius
-void rxn_arrhenius_get_used_jac_elem(int *rxn_int_data, double *rxn_float_data,
-                                     Jacobian *jac);
+void rxn_arrhenius_get_used_jac_elem(ModelData *model_data, int *rxn_int_data,
+                                     double *rxn_float_data, Jacobian *jac);
 void rxn_arrhenius_update_ids(ModelData *model_data, int *deriv_ids,
                               Jacobian jac, int *rxn_int_data,
                               double *rxn_float_data);
+void rxn_arrhenius_get_mass_action_data(int *rxn_int_data,
+                                        double *rxn_float_data,
+                                        RxnMassActionData *data);
 void rxn_arrhenius_update_env_state(ModelData *model_data, int *rxn_int_data,
                                     double *rxn_float_data,
                                     double *rxn_env_data);
+void rxn_arrhenius_calc_rate_constants(int *rxn_int_data,
+                                       double *rxn_float_data, double *env_data,
+                                       double *rxn_env_data);
 void rxn_arrhenius_print(int *rxn_int_data, double *rxn_float_data);
 #ifdef CAMP_USE_SUNDIALS
 void rxn_arrhenius_calc_deriv_contrib(ModelData *model_data,
@@ -60,14 +86,20 @@ void rxn_arrhenius_calc_jac_contrib(ModelData *model_data, Jacobian jac,
 #endif
 
 // CMAQ_H2O2
-void rxn_CMAQ_H2O2_get_used_jac_elem(int *rxn_int_data, double *rxn_float_data,
-                                     Jacobian *jac);
+void rxn_CMAQ_H2O2_get_used_jac_elem(ModelData *model_data, int *rxn_int_data,
+                                     double *rxn_float_data, Jacobian *jac);
 void rxn_CMAQ_H2O2_update_ids(ModelData *model_data, int *deriv_ids,
                               Jacobian jac, int *rxn_int_data,
                               double *rxn_float_data);
+void rxn_CMAQ_H2O2_get_mass_action_data(int *rxn_int_data,
+                                        double *rxn_float_data,
+                                        RxnMassActionData *data);
 void rxn_CMAQ_H2O2_update_env_state(ModelData *model_data, int *rxn_int_data,
                                     double *rxn_float_data,
                                     double *rxn_env_data);
+void rxn_CMAQ_H2O2_calc_rate_constants(int *rxn_int_data,
+                                       double *rxn_float_data, double *env_data,
+                                       double *rxn_env_data);
 void rxn_CMAQ_H2O2_print(int *rxn_int_data, double *rxn_float_data);
 #ifdef CAMP_USE_SUNDIALS
 void rxn_CMAQ_H2O2_calc_deriv_contrib(ModelData *model_data,
@@ -80,14 +112,22 @@ void rxn_CMAQ_H2O2_calc_jac_contrib(ModelData *model_data, Jacobian jac,
 #endif
 
 // CMAQ_OH_HNO3
-void rxn_CMAQ_OH_HNO3_get_used_jac_elem(int *rxn_int_data,
+void rxn_CMAQ_OH_HNO3_get_used_jac_elem(ModelData *model_data,
+                                        int *rxn_int_data,
                                         double *rxn_float_data, Jacobian *jac);
 void rxn_CMAQ_OH_HNO3_update_ids(ModelData *model_data, int *deriv_ids,
                                  Jacobian jac, int *rxn_int_data,
                                  double *rxn_float_data);
+void rxn_CMAQ_OH_HNO3_get_mass_action_data(int *rxn_int_data,
+                                           double *rxn_float_data,
+                                           RxnMassActionData *data);
 void rxn_CMAQ_OH_HNO3_update_env_state(ModelData *model_data, int *rxn_int_data,
                                        double *rxn_float_data,
                                        double *rxn_env_data);
+void rxn_CMAQ_OH_HNO3_calc_rate_constants(int *rxn_int_data,
+                                          double *rxn_float_data,
+                                          double *env_data,
+                                          double *rxn_env_data);
 void rxn_CMAQ_OH_HNO3_print(int *rxn_int_data, double *rxn_float_data);
 #ifdef CAMP_USE_SUNDIALS
 void rxn_CMAQ_OH_HNO3_calc_deriv_contrib(
@@ -230,11 +270,14 @@ void rxn_HL_phase_transfer_calc_jac_contrib(ModelData *model_data, Jacobian jac,
 #endif
 
 // photolysis
-void rxn_photolysis_get_used_jac_elem(int *rxn_int_data, double *rxn_float_data,
-                                      Jacobian *jac);
+void rxn_photolysis_get_used_jac_elem(ModelData *model_data, int *rxn_int_data,
+                                      double *rxn_float_data, Jacobian *jac);
 void rxn_photolysis_update_ids(ModelData *model_data, int *deriv_ids,
                                Jacobian jac, int *rxn_int_data,
                                double *rxn_float_data);
+void rxn_photolysis_get_mass_action_data(int *rxn_int_data,
+                                         double *rxn_float_data,
+                                         RxnMassActionData *data);
 void rxn_photolysis_update_env_state(ModelData *model_data, int *rxn_int_data,
                                      double *rxn_float_data,
                                      double *rxn_env_data);
@@ -302,17 +345,25 @@ void rxn_surface_calc_jac_contrib(ModelData *model_data,
 #endif
 
 // ternary_chemical_activation
-void rxn_ternary_chemical_activation_get_used_jac_elem(int *rxn_int_data,
+void rxn_ternary_chemical_activation_get_used_jac_elem(ModelData *model_data,
+                                                       int *rxn_int_data,
                                                        double *rxn_float_data,
                                                        Jacobian *jac);
 void rxn_ternary_chemical_activation_update_ids(ModelData *model_data,
                                                 int *deriv_ids, Jacobian jac,
                                                 int *rxn_int_data,
                                                 double *rxn_float_data);
+void rxn_ternary_chemical_activation_get_mass_action_data(int *rxn_int_data,
+                                                          double *rxn_float_data,
+                                                          RxnMassActionData *data);
 void rxn_ternary_chemical_activation_update_env_state(ModelData *model_data,
                                                       int *rxn_int_data,
                                                       double *rxn_float_data,
                                                       double *rxn_env_data);
+void rxn_ternary_chemical_activation_calc_rate_constants(int *rxn_int_data,
+                                                         double *rxn_float_data,
+                                                         double *env_data,
+                                                         double *rxn_env_data);
 void rxn_ternary_chemical_activation_print(int *rxn_int_data,
                                            double *rxn_float_data);
 #ifdef CAMP_USE_SUNDIALS
@@ -325,12 +376,17 @@ void rxn_ternary_chemical_activation_calc_jac_contrib(
 #endif
 
 // troe
-void rxn_troe_get_used_jac_elem(int *rxn_int_data, double *rxn_float_data,
-                                Jacobian *jac);
+void rxn_troe_get_used_jac_elem(ModelData *model_data, int *rxn_int_data,
+                                double *rxn_float_data, Jacobian *jac);
 void rxn_troe_update_ids(ModelData *model_data, int *deriv_ids, Jacobian jac,
                          int *rxn_int_data, double *rxn_float_data);
+void rxn_troe_get_mass_action_data(int *rxn_int_data,
+                                   double *rxn_float_data,
+                                   RxnMassActionData *data);
 void rxn_troe_update_env_state(ModelData *model_data, int *rxn_int_data,
                                double *rxn_float_data, double *rxn_env_data);
+void rxn_troe_calc_rate_constants(int *rxn_int_data, double *rxn_float_data,
+                                  double *env_data, double *rxn_env_data);
 void rxn_troe_print(int *rxn_int_data, double *rxn_float_data);
 #ifdef CAMP_USE_SUNDIALS
 void rxn_troe_calc_deriv_contrib(ModelData *model_data,
@@ -353,6 +409,10 @@ void rxn_wennberg_no_ro2_update_env_state(ModelData *model_data,
                                           int *rxn_int_data,
                                           double *rxn_float_data,
                                           double *rxn_env_data);
+void rxn_wennberg_no_ro2_calc_rate_constants(int *rxn_int_data,
+                                             double *rxn_float_data,
+                                             double *env_data,
+                                             double *rxn_env_data);
 bool rxn_wennberg_no_ro2_update_data(void *update_data, int *rxn_int_data,
                                      double *rxn_float_data,
                                      double *rxn_env_data);
@@ -372,16 +432,24 @@ void rxn_wennberg_no_ro2_set_rate_update_data(void *update_data, int rxn_id,
                                               double base_rate);
 
 // wennberg_tunneling
-void rxn_wennberg_tunneling_get_used_jac_elem(int *rxn_int_data,
+void rxn_wennberg_tunneling_get_used_jac_elem(ModelData *model_data,
+                                              int *rxn_int_data,
                                               double *rxn_float_data,
                                               Jacobian *jac);
 void rxn_wennberg_tunneling_update_ids(ModelData *model_data, int *deriv_ids,
                                        Jacobian jac, int *rxn_int_data,
                                        double *rxn_float_data);
+void rxn_wennberg_tunneling_get_mass_action_data(int *rxn_int_data,
+                                                 double *rxn_float_data,
+                                                 RxnMassActionData *data);
 void rxn_wennberg_tunneling_update_env_state(ModelData *model_data,
                                              int *rxn_int_data,
                                              double *rxn_float_data,
                                              double *rxn_env_data);
+void rxn_wennberg_tunneling_calc_rate_constants(int *rxn_int_data,
+                                                double *rxn_float_data,
+                                                double *env_data,
+                                                double *rxn_env_data);
 bool rxn_wennberg_tunneling_update_data(void *update_data, int *rxn_int_data,
                                         double *rxn_float_data,
                                         double *rxn_env_data);
@@ -58,9 +58,22 @@
 #define PHASE_JAC_ID_(x, s, e) \
   int_data[PHASE_INT_LOC_(x) + 5 + (s) * NUM_AERO_PHASE_JAC_ELEM_(x) + e]
 #define SMALL_WATER_CONC_(x) (float_data[PHASE_REAL_LOC_(x)])
-#define EFF_RAD_JAC_ELEM_(x, e) float_data[PHASE_REAL_LOC_(x) + 1 + e]
-#define NUM_CONC_JAC_ELEM_(x, e) \
-  float_data[PHASE_REAL_LOC_(x) + 1 + NUM_AERO_PHASE_JAC_ELEM_(x) + e]
+
+// Cached aerosol properties for the current grid cell
+#define AERO_PHASE_INST_(x) \
+  (model_data->aero_rep_phase_inst_idx[AERO_REP_ID_(x)] + AERO_PHASE_ID_(x))
+#define AERO_PHASE_INST_JAC_(x) \
+  (model_data->aero_phase_inst_jac_idx[AERO_PHASE_INST_(x)])
+#define AERO_CONC_TYPE_(x) \
+  (model_data->aero_phase_inst_conc_type[AERO_PHASE_INST_(x)])
+#define EFF_RAD_(x) \
+  (model_data->grid_cell_aero_eff_radius__m[AERO_PHASE_INST_(x)])
+#define NUM_CONC_(x) \
+  (model_data->grid_cell_aero_number_conc__n_m3[AERO_PHASE_INST_(x)])
+#define EFF_RAD_JAC_ELEM_(x) \
+  (&(model_data->grid_cell_aero_eff_radius_jac_elem[AERO_PHASE_INST_JAC_(x)]))
+#define NUM_CONC_JAC_ELEM_(x) \
+  (&(model_data->grid_cell_aero_number_conc_jac_elem[AERO_PHASE_INST_JAC_(x)]))
 
 /** \brief Flag Jacobian elements used by this reaction
  *
@@ -273,33 +286,12 @@ void rxn_HL_phase_transfer_calc_deriv_contrib(
   // Calculate derivative contributions for each aerosol phase
   for (int i_phase = 0; i_phase < NUM_AERO_PHASE_; i_phase++) {
     // Get the particle effective radius (m)
-    realtype radius;
-    aero_rep_get_effective_radius__m(
-        model_data,               // model data
-        AERO_REP_ID_(i_phase),    // aerosol representation index
-        AERO_PHASE_ID_(i_phase),  // aerosol phase index
-        &radius,                  // particle effective radius (m)
-        NULL);                    // partial derivative
-
-    // Check the aerosol concentration type (per-particle or total per-phase
-    // mass)
-    int aero_conc_type = aero_rep_get_aero_conc_type(
-        model_data,                // model data
-        AERO_REP_ID_(i_phase),     // aerosol representation index
-        AERO_PHASE_ID_(i_phase));  // aerosol phase index
+    realtype radius = EFF_RAD_(i_phase);
 
     // Get the particle number concentration (#/m3) for per-particle mass
     // concentrations; otherwise set to 1
     realtype number_conc = ONE;
-    if (aero_conc_type == 0) {
-      aero_rep_get_number_conc__n_m3(
-          model_data,               // model data
-          AERO_REP_ID_(i_phase),    // aerosol representation index
-          AERO_PHASE_ID_(i_phase),  // aerosol phase index
-          &number_conc,             // particle number concentration
-                                    // (#/m3)
-          NULL);                    // partial derivative
-    }
+    if (AERO_CONC_TYPE_(i_phase) == 0) number_conc = NUM_CONC_(i_phase);
 
     // this was replaced with transition-regime rate equation
 #if 0
@@ -363,36 +355,17 @@ void rxn_HL_phase_transfer_calc_jac_contrib(ModelData *model_data, Jacobian jac,
 
   // Calculate derivative contributions for each aerosol phase
   for (int i_phase = 0; i_phase < NUM_AERO_PHASE_; i_phase++) {
-    // Get the particle effective radius (m)
-    realtype radius;
-    aero_rep_get_effective_radius__m(
-        model_data,                         // model data
-        AERO_REP_ID_(i_phase),              // aerosol representation index
-        AERO_PHASE_ID_(i_phase),            // aerosol phase index
-        &radius,                            // particle effective radius (m)
-        &(EFF_RAD_JAC_ELEM_(i_phase, 0)));  // partial derivative
-
-    // Check the aerosol concentration type (per-particle or total per-phase
-    // mass)
-    int aero_conc_type = aero_rep_get_aero_conc_type(
-        model_data,                // model data
-        AERO_REP_ID_(i_phase),     // aerosol representation index
-        AERO_PHASE_ID_(i_phase));  // aerosol phase index
-
-    // Get the particle number concentration (#/m3) for per-particle
-    // concentrations
+    // Get the particle effective radius (m) and its partial derivatives
+    realtype radius = EFF_RAD_(i_phase);
+    double *eff_rad_jac_elem = EFF_RAD_JAC_ELEM_(i_phase);
+
+    // Get the particle number concentration (#/m3) and its partial
+    // derivatives for per-particle concentrations
     realtype number_conc = ONE;
-    if (aero_conc_type == 0) {
-      aero_rep_get_number_conc__n_m3(
-          model_data,                          // model data
-          AERO_REP_ID_(i_phase),               // aerosol representation index
-          AERO_PHASE_ID_(i_phase),             // aerosol phase index
-          &number_conc,                        // particle number concentration
-                                               // (#/m3)
-          &(NUM_CONC_JAC_ELEM_(i_phase, 0)));  // partial derivative
-    } else {
-      for (int i_elem = 0; i_elem < NUM_AERO_PHASE_JAC_ELEM_(i_phase); ++i_elem)
-        NUM_CONC_JAC_ELEM_(i_phase, i_elem) = ZERO;
+    double *num_conc_jac_elem = NULL;
+    if (AERO_CONC_TYPE_(i_phase) == 0) {
+      number_conc = NUM_CONC_(i_phase);
+      num_conc_jac_elem = NUM_CONC_JAC_ELEM_(i_phase);
     }
 
     // this was replaced with transition-regime rate equation
@@ -466,20 +439,21 @@ void rxn_HL_phase_transfer_calc_jac_contrib(ModelData *model_data, Jacobian jac,
         jacobian_add_value(
             jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
             JACOBIAN_PRODUCTION,
-            number_conc * d_evap_d_radius * EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+            number_conc * d_evap_d_radius * eff_rad_jac_elem[i_elem]);
         jacobian_add_value(
             jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
             JACOBIAN_LOSS,
-            number_conc * d_cond_d_radius * EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+            number_conc * d_cond_d_radius * eff_rad_jac_elem[i_elem]);
 
         // species involved in number concentration
-        jacobian_add_value(
-            jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
-            JACOBIAN_PRODUCTION,
-            evap_rate * NUM_CONC_JAC_ELEM_(i_phase, i_elem));
-        jacobian_add_value(
-            jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
-            JACOBIAN_LOSS, cond_rate * NUM_CONC_JAC_ELEM_(i_phase, i_elem));
+        if (num_conc_jac_elem != NULL) {
+          jacobian_add_value(
+              jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
+              JACOBIAN_PRODUCTION, evap_rate * num_conc_jac_elem[i_elem]);
+          jacobian_add_value(
+              jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
+              JACOBIAN_LOSS, cond_rate * num_conc_jac_elem[i_elem]);
+        }
       }
 
       // Aerosol-phase species dependencies
@@ -488,13 +462,11 @@ void rxn_HL_phase_transfer_calc_jac_contrib(ModelData *model_data, Jacobian jac,
         jacobian_add_value(
             jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
             JACOBIAN_LOSS,
-            d_evap_d_radius / KGM3_TO_PPM_ *
-                EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+            d_evap_d_radius / KGM3_TO_PPM_ * eff_rad_jac_elem[i_elem]);
         jacobian_add_value(
             jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
             JACOBIAN_PRODUCTION,
-            d_cond_d_radius / KGM3_TO_PPM_ *
-                EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+            d_cond_d_radius / KGM3_TO_PPM_ * eff_rad_jac_elem[i_elem]);
       }
     }
   }
@@ -66,13 +66,30 @@
 #define NUM_AERO_PHASE_JAC_ELEM_(x) (int_data[PHASE_INT_LOC_(x)])
 #define PHASE_JAC_ID_(x, s, e) \
   int_data[PHASE_INT_LOC_(x) + 1 + (s) * NUM_AERO_PHASE_JAC_ELEM_(x) + e]
-#define EFF_RAD_JAC_ELEM_(x, e) float_data[PHASE_FLOAT_LOC_(x) + e]
-#define NUM_CONC_JAC_ELEM_(x, e) \
-  float_data[PHASE_FLOAT_LOC_(x) + NUM_AERO_PHASE_JAC_ELEM_(x) + e]
-#define MASS_JAC_ELEM_(x, e) \
-  float_data[PHASE_FLOAT_LOC_(x) + 2 * NUM_AERO_PHASE_JAC_ELEM_(x) + e]
-#define MW_JAC_ELEM_(x, e) \
-  float_data[PHASE_FLOAT_LOC_(x) + 3 * NUM_AERO_PHASE_JAC_ELEM_(x) + e]
+
+// Cached aerosol properties for the current grid cell
+#define AERO_PHASE_INST_(x) \
+  (model_data->aero_rep_phase_inst_idx[AERO_REP_ID_(x)] + AERO_PHASE_ID_(x))
+#define AERO_PHASE_INST_JAC_(x) \
+  (model_data->aero_phase_inst_jac_idx[AERO_PHASE_INST_(x)])
+#define AERO_CONC_TYPE_(x) \
+  (model_data->aero_phase_inst_conc_type[AERO_PHASE_INST_(x)])
+#define EFF_RAD_(x) \
+  (model_data->grid_cell_aero_eff_radius__m[AERO_PHASE_INST_(x)])
+#define NUM_CONC_(x) \
+  (model_data->grid_cell_aero_number_conc__n_m3[AERO_PHASE_INST_(x)])
+#define AERO_PHASE_MASS_(x) \
+  (model_data->grid_cell_aero_phase_mass__kg_m3[AERO_PHASE_INST_(x)])
+#define AERO_PHASE_AVG_MW_(x) \
+  (model_data->grid_cell_aero_phase_avg_MW__kg_mol[AERO_PHASE_INST_(x)])
+#define EFF_RAD_JAC_ELEM_(x) \
+  (&(model_data->grid_cell_aero_eff_radius_jac_elem[AERO_PHASE_INST_JAC_(x)]))
+#define NUM_CONC_JAC_ELEM_(x) \
+  (&(model_data->grid_cell_aero_number_conc_jac_elem[AERO_PHASE_INST_JAC_(x)]))
+#define MASS_JAC_ELEM_(x) \
+  (&(model_data->grid_cell_aero_phase_mass_jac_elem[AERO_PHASE_INST_JAC_(x)]))
+#define MW_JAC_ELEM_(x) \
+  (&(model_data->grid_cell_aero_phase_avg_MW_jac_elem[AERO_PHASE_INST_JAC_(x)]))
 
 /** \brief Flag Jacobian elements used by this reaction
  *
@@ -287,47 +304,20 @@ void rxn_SIMPOL_phase_transfer_calc_deriv_contrib(
   // Calculate derivative contributions for each aerosol phase
   for (int i_phase = 0; i_phase < NUM_AERO_PHASE_; i_phase++) {
     // Get the particle effective radius (m)
-    realtype radius;
-    aero_rep_get_effective_radius__m(
-        model_data,               // model data
-        AERO_REP_ID_(i_phase),    // aerosol representation index
-        AERO_PHASE_ID_(i_phase),  // aerosol phase index
-        &radius,                  // particle effective radius (m)
-        NULL);                    // partial derivative
+    realtype radius = EFF_RAD_(i_phase);
 
     // Check the aerosol concentration type (per-particle or total per-phase
     // mass)
-    int aero_conc_type = aero_rep_get_aero_conc_type(
-        model_data,                // model data
-        AERO_REP_ID_(i_phase),     // aerosol representation index
-        AERO_PHASE_ID_(i_phase));  // aerosol phase index
+    int aero_conc_type = AERO_CONC_TYPE_(i_phase);
 
     // Get the particle number concentration (#/m3)
-    realtype number_conc;
-    aero_rep_get_number_conc__n_m3(
-        model_data,               // model data
-        AERO_REP_ID_(i_phase),    // aerosol representation index
-        AERO_PHASE_ID_(i_phase),  // aerosol phase index
-        &number_conc,             // particle number conc (#/m3)
-        NULL);                    // partial derivative
+    realtype number_conc = NUM_CONC_(i_phase);
 
     // Get the total mass of the aerosol phase (kg/m3)
-    realtype aero_phase_mass;
-    aero_rep_get_aero_phase_mass__kg_m3(
-        model_data,               // model data
-        AERO_REP_ID_(i_phase),    // aerosol representation index
-        AERO_PHASE_ID_(i_phase),  // aerosol phase index
-        &aero_phase_mass,         // total aerosol-phase mass (kg/m3)
-        NULL);                    // partial derivatives
+    realtype aero_phase_mass = AERO_PHASE_MASS_(i_phase);
 
     // Get the total mass of the aerosol phase (kg/mol)
-    realtype aero_phase_avg_MW;
-    aero_rep_get_aero_phase_avg_MW__kg_mol(
-        model_data,               // model data
-        AERO_REP_ID_(i_phase),    // aerosol representation index
-        AERO_PHASE_ID_(i_phase),  // aerosol phase index
-        &aero_phase_avg_MW,       // avg MW in the aerosol phase (kg/mol)
-        NULL);                    // partial derivatives
+    realtype aero_phase_avg_MW = AERO_PHASE_AVG_MW_(i_phase);
 
     // This was replaced with the transition-regime condensation rate
     // equations
@@ -425,47 +415,24 @@ void rxn_SIMPOL_phase_transfer_calc_jac_contrib(ModelData *model_data,
   // Calculate derivative contributions for each aerosol phase
   for (int i_phase = 0; i_phase < NUM_AERO_PHASE_; i_phase++) {
     // Get the particle effective radius (m)
-    realtype radius;
-    aero_rep_get_effective_radius__m(
-        model_data,                         // model data
-        AERO_REP_ID_(i_phase),              // aerosol representation index
-        AERO_PHASE_ID_(i_phase),            // aerosol phase index
-        &radius,                            // particle effective radius (m)
-        &(EFF_RAD_JAC_ELEM_(i_phase, 0)));  // partial derivative
+    realtype radius = EFF_RAD_(i_phase);
+    double *eff_rad_jac_elem = EFF_RAD_JAC_ELEM_(i_phase);
 
     // Check the aerosol concentration type (per-particle or total per-phase
     // mass)
-    int aero_conc_type = aero_rep_get_aero_conc_type(
-        model_data,                // model data
-        AERO_REP_ID_(i_phase),     // aerosol representation index
-        AERO_PHASE_ID_(i_phase));  // aerosol phase index
+    int aero_conc_type = AERO_CONC_TYPE_(i_phase);
 
     // Get the particle number concentration (#/m3)
-    realtype number_conc;
-    aero_rep_get_number_conc__n_m3(
-        model_data,                          // model data
-        AERO_REP_ID_(i_phase),               // aerosol representation index
-        AERO_PHASE_ID_(i_phase),             // aerosol phase index
-        &number_conc,                        // particle number conc (#/m3)
-        &(NUM_CONC_JAC_ELEM_(i_phase, 0)));  // partial derivative
+    realtype number_conc = NUM_CONC_(i_phase);
+    double *num_conc_jac_elem = NUM_CONC_JAC_ELEM_(i_phase);
 
     // Get the total mass of the aerosol phase (kg/m3)
-    realtype aero_phase_mass;
-    aero_rep_get_aero_phase_mass__kg_m3(
-        model_data,                      // model data
-        AERO_REP_ID_(i_phase),           // aerosol representation index
-        AERO_PHASE_ID_(i_phase),         // aerosol phase index
-        &aero_phase_mass,                // total aerosol-phase mass (kg/m3)
-        &(MASS_JAC_ELEM_(i_phase, 0)));  // partial derivatives
+    realtype aero_phase_mass = AERO_PHASE_MASS_(i_phase);
+    double *mass_jac_elem = MASS_JAC_ELEM_(i_phase);
 
     // Get the total average MW of the aerosol phase (kg/mol)
-    realtype aero_phase_avg_MW;
-    aero_rep_get_aero_phase_avg_MW__kg_mol(
-        model_data,                    // model data
-        AERO_REP_ID_(i_phase),         // aerosol representation index
-        AERO_PHASE_ID_(i_phase),       // aerosol phase index
-        &aero_phase_avg_MW,            // avg MW in the aerosol phase (kg/mol)
-        &(MW_JAC_ELEM_(i_phase, 0)));  // partial derivatives
+    realtype aero_phase_avg_MW = AERO_PHASE_AVG_MW_(i_phase);
+    double *MW_jac_elem = MW_JAC_ELEM_(i_phase);
 
     // This was replaced with the transition-regime condensation rate
     // equations
@@ -600,33 +567,33 @@ void rxn_SIMPOL_phase_transfer_calc_jac_contrib(ModelData *model_data,
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_PRODUCTION,
               number_conc * d_evap_d_radius *
-                  EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+                  eff_rad_jac_elem[i_elem]);
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_LOSS,
               number_conc * d_cond_d_radius *
-                  EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+                  eff_rad_jac_elem[i_elem]);
 
           // species involved in number concentration
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_PRODUCTION,
-              evap_rate * NUM_CONC_JAC_ELEM_(i_phase, i_elem));
+              evap_rate * num_conc_jac_elem[i_elem]);
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
-              JACOBIAN_LOSS, cond_rate * NUM_CONC_JAC_ELEM_(i_phase, i_elem));
+              JACOBIAN_LOSS, cond_rate * num_conc_jac_elem[i_elem]);
 
           // species involved in mass calculations
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_PRODUCTION,
-              number_conc * d_evap_d_mass * MASS_JAC_ELEM_(i_phase, i_elem));
+              number_conc * d_evap_d_mass * mass_jac_elem[i_elem]);
 
           // species involved in average MW calculations
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_PRODUCTION,
-              number_conc * d_evap_d_MW * MW_JAC_ELEM_(i_phase, i_elem));
+              number_conc * d_evap_d_MW * MW_jac_elem[i_elem]);
         }
 
         // Aerosol-phase species dependencies
@@ -636,24 +603,24 @@ void rxn_SIMPOL_phase_transfer_calc_jac_contrib(ModelData *model_data,
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_LOSS,
               d_evap_d_radius / KGM3_TO_PPM_ *
-                  EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+                  eff_rad_jac_elem[i_elem]);
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_PRODUCTION,
               d_cond_d_radius / KGM3_TO_PPM_ *
-                  EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+                  eff_rad_jac_elem[i_elem]);
 
           // species involved in mass calculations
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_LOSS,
-              d_evap_d_mass / KGM3_TO_PPM_ * MASS_JAC_ELEM_(i_phase, i_elem));
+              d_evap_d_mass / KGM3_TO_PPM_ * mass_jac_elem[i_elem]);
 
           // species involved in average MW calculations
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_LOSS,
-              d_evap_d_MW / KGM3_TO_PPM_ * MW_JAC_ELEM_(i_phase, i_elem));
+              d_evap_d_MW / KGM3_TO_PPM_ * MW_jac_elem[i_elem]);
         }
       }
 
@@ -669,33 +636,33 @@ void rxn_SIMPOL_phase_transfer_calc_jac_contrib(ModelData *model_data,
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_PRODUCTION,
               number_conc * d_evap_d_radius *
-                  EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+                  eff_rad_jac_elem[i_elem]);
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_LOSS,
               number_conc * d_cond_d_radius *
-                  EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+                  eff_rad_jac_elem[i_elem]);
 
           // species involved in number concentration
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_PRODUCTION,
-              evap_rate * NUM_CONC_JAC_ELEM_(i_phase, i_elem));
+              evap_rate * num_conc_jac_elem[i_elem]);
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
-              JACOBIAN_LOSS, cond_rate * NUM_CONC_JAC_ELEM_(i_phase, i_elem));
+              JACOBIAN_LOSS, cond_rate * num_conc_jac_elem[i_elem]);
 
           // species involved in mass calculations
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_PRODUCTION,
-              number_conc * d_evap_d_mass * MASS_JAC_ELEM_(i_phase, i_elem));
+              number_conc * d_evap_d_mass * mass_jac_elem[i_elem]);
 
           // species involved in average MW calculations
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_GAS, i_elem),
               JACOBIAN_PRODUCTION,
-              number_conc * d_evap_d_MW * MW_JAC_ELEM_(i_phase, i_elem));
+              number_conc * d_evap_d_MW * MW_jac_elem[i_elem]);
         }
 
         // Aerosol-phase species dependencies
@@ -705,36 +672,36 @@ void rxn_SIMPOL_phase_transfer_calc_jac_contrib(ModelData *model_data,
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_LOSS,
               number_conc * d_evap_d_radius / KGM3_TO_PPM_ *
-                  EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+                  eff_rad_jac_elem[i_elem]);
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_PRODUCTION,
               number_conc * d_cond_d_radius / KGM3_TO_PPM_ *
-                  EFF_RAD_JAC_ELEM_(i_phase, i_elem));
+                  eff_rad_jac_elem[i_elem]);
 
           // species involved in number concentration
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_LOSS,
-              evap_rate / KGM3_TO_PPM_ * NUM_CONC_JAC_ELEM_(i_phase, i_elem));
+              evap_rate / KGM3_TO_PPM_ * num_conc_jac_elem[i_elem]);
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_PRODUCTION,
-              cond_rate / KGM3_TO_PPM_ * NUM_CONC_JAC_ELEM_(i_phase, i_elem));
+              cond_rate / KGM3_TO_PPM_ * num_conc_jac_elem[i_elem]);
 
           // species involved in mass calculations
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_LOSS,
               number_conc * d_evap_d_mass / KGM3_TO_PPM_ *
-                  MASS_JAC_ELEM_(i_phase, i_elem));
+                  mass_jac_elem[i_elem]);
 
           // species involved in average MW calculations
           jacobian_add_value(
               jac, (unsigned int)PHASE_JAC_ID_(i_phase, JAC_AERO, i_elem),
               JACOBIAN_LOSS,
               number_conc * d_evap_d_MW / KGM3_TO_PPM_ *
-                  MW_JAC_ELEM_(i_phase, i_elem));
+                  MW_jac_elem[i_elem]);
         }
       }
     }
@@ -782,18 +749,6 @@ void rxn_SIMPOL_phase_transfer_print(int *rxn_int_data,
     printf("\n  dAero/dx ids:");
     for (int j = 0; j < NUM_AERO_PHASE_JAC_ELEM_(i); ++j)
       printf(" %d", PHASE_JAC_ID_(i, JAC_AERO, j));
-    printf("\n  Effective radius Jac elem:");
-    for (int j = 0; j < NUM_AERO_PHASE_JAC_ELEM_(i); ++j)
-      printf(" %le", EFF_RAD_JAC_ELEM_(i, j));
-    printf("\n  Number concentration Jac elem:");
-    for (int j = 0; j < NUM_AERO_PHASE_JAC_ELEM_(i); ++j)
-      printf(" %le", NUM_CONC_JAC_ELEM_(i, j));
-    printf("\n  Aerosol mass Jac elem:");
-    for (int j = 0; j < NUM_AERO_PHASE_JAC_ELEM_(i); ++j)
-      printf(" %le", MASS_JAC_ELEM_(i, j));
-    printf("\n  Average MW Jac elem:");
-    for (int j = 0; j < NUM_AERO_PHASE_JAC_ELEM_(i); ++j)
-      printf(" %le", MW_JAC_ELEM_(i, j));
   }
 
   return;
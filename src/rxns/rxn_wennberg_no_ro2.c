@@ -116,23 +116,19 @@ double calculate_A(double T, double M, double n) {
          pow(0.41, 1.0 / (1.0 + pow(log10(k0 * M / kinf), 2)));
 }
 
-/** \brief Update reaction data for new environmental conditions
- *
- * For Wennberg NO + RO2 reaction this only involves recalculating the rate
- * constant.
+/** \brief Calculate the rate constants for a given environmental state
  *
- * \param model_data Pointer to the model data
  * \param rxn_int_data Pointer to the reaction integer data
  * \param rxn_float_data Pointer to the reaction floating-point data
+ * \param env_data Pointer to the environmental state array
  * \param rxn_env_data Pointer to the environment-dependent parameters
  */
-void rxn_wennberg_no_ro2_update_env_state(ModelData *model_data,
-                                          int *rxn_int_data,
-                                          double *rxn_float_data,
-                                          double *rxn_env_data) {
+void rxn_wennberg_no_ro2_calc_rate_constants(int *rxn_int_data,
+                                             double *rxn_float_data,
+                                             double *env_data,
+                                             double *rxn_env_data) {
   int *int_data = rxn_int_data;
   double *float_data = rxn_float_data;
-  double *env_data = model_data->grid_cell_env;
 
   double base_rate, A, Z, M;
 
@@ -144,6 +140,31 @@ void rxn_wennberg_no_ro2_update_env_state(ModelData *model_data,
   A = calculate_A(TEMPERATURE_K_, M, n_);
   ALKOXY_RATE_CONSTANT_ = base_rate * Z / (Z + A);
   NITRATE_RATE_CONSTANT_ = base_rate * A / (A + Z);
+
+  return;
+}
+
+/** \brief Update reaction data for new environmental conditions
+ *
+ * For Wennberg NO + RO2 reaction this only involves recalculating the rate
+ * constant.
+ *
+ * \param model_data Pointer to the model data
+ * \param rxn_int_data Pointer to the reaction integer data
+ * \param rxn_float_data Pointer to the reaction floating-point data
+ * \param rxn_env_data Pointer to the environment-dependent parameters
+ */
+void rxn_wennberg_no_ro2_update_env_state(ModelData *model_data,
+                                          int *rxn_int_data,
+                                          double *rxn_float_data,
+                                          double *rxn_env_data) {
+  // Get the rate constants from the lookup table when available,
+  // otherwise calculate them
+  if (!rxn_rate_table_get_values(model_data, rxn_env_data, 2))
+    rxn_wennberg_no_ro2_calc_rate_constants(rxn_int_data, rxn_float_data,
+                                            model_data->grid_cell_env,
+                                            rxn_env_data);
+
   return;
 }
 
@@ -25,29 +25,40 @@
 #define C_ float_data[2]
 #define CONV_ float_data[3]
 #define RATE_CONSTANT_ rxn_env_data[0]
-#define NUM_INT_PROP_ 2
+#define NUM_CONST_REACT_ int_data[2]
+#define NUM_INT_PROP_ 3
 #define NUM_FLOAT_PROP_ 4
 #define NUM_ENV_PARAM_ 1
 #define REACT_(x) (int_data[NUM_INT_PROP_ + x] - 1)
 #define PROD_(x) (int_data[NUM_INT_PROP_ + NUM_REACT_ + x] - 1)
 #define DERIV_ID_(x) int_data[NUM_INT_PROP_ + NUM_REACT_ + NUM_PROD_ + x]
 #define JAC_ID_(x) int_data[NUM_INT_PROP_ + 2 * (NUM_REACT_ + NUM_PROD_) + x]
+#define NUM_VAR_REACT_ (NUM_REACT_ - NUM_CONST_REACT_)
 #define YIELD_(x) float_data[NUM_FLOAT_PROP_ + x]
 
 /** \brief Flag Jacobian elements used by this reaction
  *
+ * Constant reactants are moved to the end of the reactant list. Their
+ * concentrations are folded into the rate constant, so they do not need
+ * Jacobian elements.
+ *
+ * \param model_data Pointer to the model data
  * \param rxn_int_data Pointer to the reaction integer data
  * \param rxn_float_data Pointer to the reaction floating-point data
  * \param jac Jacobian
  */
-void rxn_wennberg_tunneling_get_used_jac_elem(int *rxn_int_data,
+void rxn_wennberg_tunneling_get_used_jac_elem(ModelData *model_data,
+                                              int *rxn_int_data,
                                               double *rxn_float_data,
                                               Jacobian *jac) {
   int *int_data = rxn_int_data;
   double *float_data = rxn_float_data;
 
-  for (int i_ind = 0; i_ind < NUM_REACT_; i_ind++) {
-    for (int i_dep = 0; i_dep < NUM_REACT_; i_dep++) {
+  NUM_CONST_REACT_ = rxn_sort_constant_reactants(
+      model_data, &(int_data[NUM_INT_PROP_]), NUM_REACT_);
+
+  for (int i_ind = 0; i_ind < NUM_VAR_REACT_; i_ind++) {
+    for (int i_dep = 0; i_dep < NUM_VAR_REACT_; i_dep++) {
       jacobian_register_element(jac, REACT_(i_dep), REACT_(i_ind));
     }
     for (int i_dep = 0; i_dep < NUM_PROD_; i_dep++) {
@@ -77,19 +88,70 @@ void rxn_wennberg_tunneling_update_ids(ModelData *model_data, int *deriv_ids,
   for (int i = 0; i < NUM_PROD_; i++)
     DERIV_ID_(i + NUM_REACT_) = deriv_ids[PROD_(i)];
 
-  // Update the Jacobian ids
+  // Update the Jacobian ids (constant reactants have no Jacobian elements)
   int i_jac = 0;
   for (int i_ind = 0; i_ind < NUM_REACT_; i_ind++) {
     for (int i_dep = 0; i_dep < NUM_REACT_; i_dep++)
       JAC_ID_(i_jac++) =
-          jacobian_get_element_id(jac, REACT_(i_dep), REACT_(i_ind));
+          i_ind < NUM_VAR_REACT_ && i_dep < NUM_VAR_REACT_
+              ? jacobian_get_element_id(jac, REACT_(i_dep), REACT_(i_ind))
+              : -1;
     for (int i_dep = 0; i_dep < NUM_PROD_; i_dep++)
       JAC_ID_(i_jac++) =
-          jacobian_get_element_id(jac, PROD_(i_dep), REACT_(i_ind));
+          i_ind < NUM_VAR_REACT_
+              ? jacobian_get_element_id(jac, PROD_(i_dep), REACT_(i_ind))
+              : -1;
   }
   return;
 }
 
+/** \brief Get the reactant, product and index data of the reaction
+ *
+ * Used to build the compact encoding of the reaction data for the solver.
+ *
+ * \param rxn_int_data Pointer to the reaction integer data
+ * \param rxn_float_data Pointer to the reaction floating-point data
+ * \param data Mass-action reaction data to set
+ */
+void rxn_wennberg_tunneling_get_mass_action_data(int *rxn_int_data,
+                                                 double *rxn_float_data,
+                                                 RxnMassActionData *data) {
+  int *int_data = rxn_int_data;
+  double *float_data = rxn_float_data;
+
+  data->n_react = NUM_REACT_;
+  data->n_var_react = NUM_VAR_REACT_;
+  data->n_prod = NUM_PROD_;
+  data->react_ids = &(int_data[NUM_INT_PROP_]);
+  data->prod_ids = &(int_data[NUM_INT_PROP_ + NUM_REACT_]);
+  data->deriv_ids = &(DERIV_ID_(0));
+  data->jac_ids = &(JAC_ID_(0));
+  data->yields = &(YIELD_(0));
+}
+
+/** \brief Calculate the rate constant for a given environmental state
+ *
+ * \param rxn_int_data Pointer to the reaction integer data
+ * \param rxn_float_data Pointer to the reaction floating-point data
+ * \param env_data Pointer to the environmental state array
+ * \param rxn_env_data Pointer to the environment-dependent parameters
+ */
+void rxn_wennberg_tunneling_calc_rate_constants(int *rxn_int_data,
+                                                double *rxn_float_data,
+                                                double *env_data,
+                                                double *rxn_env_data) {
+  int *int_data = rxn_int_data;
+  double *float_data = rxn_float_data;
+
+  // Calculate the rate constant in (#/cc)
+  // k = A * exp(-B/T) * exp(C/T^3)
+  RATE_CONSTANT_ = A_ * exp(-B_ / TEMPERATURE_K_) *
+                   exp(C_ / pow(TEMPERATURE_K_, 3)) *
+                   pow(CONV_ * PRESSURE_PA_ / TEMPERATURE_K_, NUM_REACT_ - 1);
+
+  return;
+}
+
 /** \brief Update reaction data for new environmental conditions
  *
  * For Wennberg tunneling reaction this only involves recalculating the rate
@@ -105,14 +167,17 @@ void rxn_wennberg_tunneling_update_env_state(ModelData *model_data,
                                              double *rxn_float_data,
                                              double *rxn_env_data) {
   int *int_data = rxn_int_data;
-  double *float_data = rxn_float_data;
-  double *env_data = model_data->grid_cell_env;
 
-  // Calculate the rate constant in (#/cc)
-  // k = A * exp(-B/T) * exp(C/T^3)
-  RATE_CONSTANT_ = A_ * exp(-B_ / TEMPERATURE_K_) *
-                   exp(C_ / pow(TEMPERATURE_K_, 3)) *
-                   pow(CONV_ * PRESSURE_PA_ / TEMPERATURE_K_, NUM_REACT_ - 1);
+  // Get the rate constant from the lookup table when available, otherwise
+  // calculate it
+  if (!rxn_rate_table_get_values(model_data, rxn_env_data, 1))
+    rxn_wennberg_tunneling_calc_rate_constants(rxn_int_data, rxn_float_data,
+                                               model_data->grid_cell_env,
+                                               rxn_env_data);
+
+  // Include the constant reactant concentrations
+  for (int i_spec = NUM_VAR_REACT_; i_spec < NUM_REACT_; i_spec++)
+    RATE_CONSTANT_ *= model_data->grid_cell_state[REACT_(i_spec)];
 
   return;
 }
@@ -138,16 +203,17 @@ void rxn_wennberg_tunneling_calc_deriv_contrib(
 
   // Calculate the reaction rate
   long double rate = RATE_CONSTANT_;
-  for (int i_spec = 0; i_spec < NUM_REACT_; i_spec++)
+  for (int i_spec = 0; i_spec < NUM_VAR_REACT_; i_spec++)
     rate *= state[REACT_(i_spec)];
 
   // Add contributions to the time derivative
   if (rate != ZERO) {
     int i_dep_var = 0;
-    for (int i_spec = 0; i_spec < NUM_REACT_; i_spec++, i_dep_var++) {
+    for (int i_spec = 0; i_spec < NUM_VAR_REACT_; i_spec++, i_dep_var++) {
       if (DERIV_ID_(i_dep_var) < 0) continue;
       time_derivative_add_value(time_deriv, DERIV_ID_(i_dep_var), -rate);
     }
+    i_dep_var = NUM_REACT_;
     for (int i_spec = 0; i_spec < NUM_PROD_; i_spec++, i_dep_var++) {
       if (DERIV_ID_(i_dep_var) < 0) continue;
 
@@ -186,10 +252,10 @@ void rxn_wennberg_tunneling_calc_jac_contrib(ModelData *model_data,
 
   // Add contributions to the Jacobian
   int i_elem = 0;
-  for (int i_ind = 0; i_ind < NUM_REACT_; i_ind++) {
+  for (int i_ind = 0; i_ind < NUM_VAR_REACT_; i_ind++) {
     // Calculate d_rate / d_i_ind
     realtype rate = RATE_CONSTANT_;
-    for (int i_spec = 0; i_spec < NUM_REACT_; i_spec++)
+    for (int i_spec = 0; i_spec < NUM_VAR_REACT_; i_spec++)
       if (i_spec != i_ind) rate *= state[REACT_(i_spec)];
 
     for (int i_dep = 0; i_dep < NUM_REACT_; i_dep++, i_elem++) {
@@ -0,0 +1,35 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Solver timer functions
+ *
+ */
+/** \file
+ * \brief Solver timer functions
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include "solver_timers.h"
+#include <time.h>
+
+double solver_timer_now(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + 1.0e-9 * (double)now.tv_nsec;
+}
+
+void solver_timers_reset(SolverTimers *timers) {
+  for (int i_timer = 0; i_timer < SOLVER_NUM_TIMERS; ++i_timer) {
+    timers->time__s[i_timer] = 0.0;
+    timers->calls[i_timer] = 0;
+  }
+}
+
+double solver_timers_add(SolverTimers *timers, SolverTimerId timer_id,
+                         double start__s) {
+  double now__s = solver_timer_now();
+  timers->time__s[timer_id] += now__s - start__s;
+  ++(timers->calls[timer_id]);
+  return now__s;
+}
@@ -0,0 +1,59 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the solver timers and related functions
+ *
+ */
+/** \file
+ * \brief Header for the solver timers and related functions
+ */
+#ifndef SOLVER_TIMERS_H_
+#define SOLVER_TIMERS_H_
+
+/* Solver phases with separate timers (the order must match the phase time
+ * array in the camp_solver_stats module) */
+typedef enum {
+  SOLVER_TIMER_UPDATE_ENV_STATE,  // Updates for new environmental states
+  SOLVER_TIMER_AERO_REP_UPDATE,   // Aerosol representation state updates
+  SOLVER_TIMER_SUB_MODEL_CALC,    // Sub-model calculations
+  SOLVER_TIMER_RXN_DERIV,         // Reaction derivative contributions
+  SOLVER_TIMER_RXN_JAC,           // Reaction Jacobian contributions
+  SOLVER_TIMER_JAC_ASSEMBLY,      // Solver Jacobian assembly
+  SOLVER_TIMER_LS_SETUP,          // Linear solver setup (factorization)
+  SOLVER_TIMER_LS_SOLVE,          // Linear solver solves
+  SOLVER_TIMER_GUESS_HELPER,      // Guess helper (including its calls to f())
+  SOLVER_TIMER_DERIV,             // Calls to f()
+  SOLVER_TIMER_JAC,               // Calls to Jac()
+  SOLVER_NUM_TIMERS
+} SolverTimerId;
+
+/* Accumulated wall-clock time and number of calls for each solver phase */
+typedef struct {
+  double time__s[SOLVER_NUM_TIMERS];  // Total time in each phase (s)
+  long int calls[SOLVER_NUM_TIMERS];  // Number of times each phase was timed
+} SolverTimers;
+
+/** \brief Get the current time from a monotonic clock
+ *
+ * \return Time (s) from an arbitrary starting point
+ */
+double solver_timer_now(void);
+
+/** \brief Reset all the timers
+ *
+ * \param timers Pointer to the SolverTimers object
+ */
+void solver_timers_reset(SolverTimers *timers);
+
+/** \brief Add the time elapsed since a start time to a timer
+ *
+ * \param timers Pointer to the SolverTimers object
+ * \param timer_id Timer to add the elapsed time to
+ * \param start__s Start time (s) from \c solver_timer_now()
+ * \return Current time (s), for use as the start time of a following phase
+ */
+double solver_timers_add(SolverTimers *timers, SolverTimerId timer_id,
+                         double start__s);
+
+#endif
@@ -0,0 +1,93 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Solver event tracer functions
+ *
+ */
+/** \file
+ * \brief Solver event tracer functions
+ */
+#include "solver_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Event names (the order must match SolverTraceEventId)
+static const char *event_names[SOLVER_TRACE_NUM_EVENTS] = {
+    "solver_run",           "f",
+    "Jac",                  "linear solver setup",
+    "linear solver solve",  "guess_helper",
+    "rxn_update_data",      "aero_rep_update_data",
+    "sub_model_update_data"};
+
+void solver_trace_initialize(SolverTrace *trace) {
+  trace->events = NULL;
+  trace->max_events = 0;
+  trace->n_recorded = 0;
+  trace->file_name = NULL;
+  trace->process_id = 0;
+  trace->thread_id = 0;
+}
+
+int solver_trace_start(SolverTrace *trace, const char *file_name,
+                       int process_id, int thread_id, long int max_events) {
+  solver_trace_free(trace);
+  if (max_events <= 0) max_events = SOLVER_TRACE_DEFAULT_MAX_EVENTS;
+  trace->events =
+      (SolverTraceEvent *)malloc(max_events * sizeof(SolverTraceEvent));
+  trace->file_name = (char *)malloc((strlen(file_name) + 1) * sizeof(char));
+  if (trace->events == NULL || trace->file_name == NULL) {
+    free(trace->events);
+    free(trace->file_name);
+    solver_trace_initialize(trace);
+    return 0;
+  }
+  strcpy(trace->file_name, file_name);
+  trace->max_events = max_events;
+  trace->n_recorded = 0;
+  trace->process_id = process_id;
+  trace->thread_id = thread_id;
+  return 1;
+}
+
+int solver_trace_write(SolverTrace trace) {
+  if (trace.events == NULL) return 0;
+  FILE *f = fopen(trace.file_name, "w");
+  if (f == NULL) {
+    printf("\n\nWARNING Could not open solver trace file '%s'\n\n",
+           trace.file_name);
+    return 0;
+  }
+
+  // Write the events oldest first, with times in microseconds relative to
+  // the oldest event
+  long int n_events = trace.n_recorded < trace.max_events ? trace.n_recorded
+                                                          : trace.max_events;
+  long int first = trace.n_recorded - n_events;
+  double origin__s =
+      n_events > 0 ? trace.events[first % trace.max_events].start__s : 0.0;
+  fprintf(f, "{\"traceEvents\":[");
+  for (long int i_event = first; i_event < trace.n_recorded; ++i_event) {
+    SolverTraceEvent event = trace.events[i_event % trace.max_events];
+    fprintf(f,
+            "%s\n{\"name\":\"%s\",\"cat\":\"camp\",\"ph\":\"X\","
+            "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+            i_event == first ? "" : ",", event_names[event.event_id],
+            (event.start__s - origin__s) * 1.0e6, event.duration__s * 1.0e6,
+            trace.process_id, trace.thread_id);
+  }
+  fprintf(f,
+          "\n],\"displayTimeUnit\":\"ms\",\"otherData\":"
+          "{\"dropped_events\":%ld}}\n",
+          first);
+  fclose(f);
+  return 1;
+}
+
+void solver_trace_free(SolverTrace *trace) {
+  solver_trace_write(*trace);
+  free(trace->events);
+  free(trace->file_name);
+  solver_trace_initialize(trace);
+}
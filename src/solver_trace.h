@@ -0,0 +1,113 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the solver event tracer and related functions
+ *
+ */
+/** \file
+ * \brief Header for the solver event tracer and related functions
+ */
+#ifndef SOLVER_TRACE_H_
+#define SOLVER_TRACE_H_
+
+#include <stdlib.h>
+
+// Default number of events kept in the trace buffer
+#define SOLVER_TRACE_DEFAULT_MAX_EVENTS 1048576
+
+/* Traced solver events (the order must match the event names in
+ * solver_trace.c) */
+typedef enum {
+  SOLVER_TRACE_SOLVER_RUN,             // Calls to solver_run()
+  SOLVER_TRACE_DERIV,                  // Calls to f()
+  SOLVER_TRACE_JAC,                    // Calls to Jac()
+  SOLVER_TRACE_LS_SETUP,               // Linear solver setup (factorization)
+  SOLVER_TRACE_LS_SOLVE,               // Linear solver solves
+  SOLVER_TRACE_GUESS_HELPER,           // Guess helper calls
+  SOLVER_TRACE_RXN_UPDATE_DATA,        // Host reaction data updates
+  SOLVER_TRACE_AERO_REP_UPDATE_DATA,   // Host aerosol representation updates
+  SOLVER_TRACE_SUB_MODEL_UPDATE_DATA,  // Host sub-model data updates
+  SOLVER_TRACE_NUM_EVENTS
+} SolverTraceEventId;
+
+/* A completed solver event */
+typedef struct {
+  double start__s;     // Start time (s) from solver_timer_now()
+  double duration__s;  // Duration (s)
+  int event_id;        // Event type (a SolverTraceEventId)
+} SolverTraceEvent;
+
+/* Ring buffer of solver events
+ *
+ * Each buffer belongs to one solver and is only written by the thread
+ * running that solver, so recording an event needs no locking. When the
+ * buffer is full, the oldest events are overwritten. Tracing is off when
+ * \c events is NULL.
+ */
+typedef struct {
+  SolverTraceEvent *events;  // Event buffer
+  long int max_events;       // Size of the event buffer
+  long int n_recorded;       // Number of events recorded since tracing began
+  char *file_name;           // Chrome-trace JSON file to write the events to
+  int process_id;            // Process id for the timeline (e.g., MPI rank)
+  int thread_id;             // Thread id for the timeline
+} SolverTrace;
+
+/** \brief Initialize a solver trace with tracing turned off
+ *
+ * \param trace Pointer to the SolverTrace object
+ */
+void solver_trace_initialize(SolverTrace *trace);
+
+/** \brief Start recording events
+ *
+ * Any events already recorded are first written to the previous trace
+ * file.
+ *
+ * \param trace Pointer to the SolverTrace object
+ * \param file_name File to write the trace to in Chrome-trace JSON format
+ * \param process_id Process id to use in the timeline
+ * \param thread_id Thread id to use in the timeline
+ * \param max_events Maximum number of events to keep (if <= 0, the default
+ *                   size is used)
+ * \return Flag indicating whether tracing was started (0 = false; 1 = true)
+ */
+int solver_trace_start(SolverTrace *trace, const char *file_name,
+                       int process_id, int thread_id, long int max_events);
+
+/** \brief Record a completed event, if tracing is on
+ *
+ * \param trace Pointer to the SolverTrace object
+ * \param event_id Event type
+ * \param start__s Event start time (s) from \c solver_timer_now()
+ * \param end__s Event end time (s) from \c solver_timer_now()
+ */
+static inline void solver_trace_add(SolverTrace *trace,
+                                    SolverTraceEventId event_id,
+                                    double start__s, double end__s) {
+  if (trace->events == NULL) return;
+  SolverTraceEvent *event =
+      &(trace->events[trace->n_recorded++ % trace->max_events]);
+  event->start__s = start__s;
+  event->duration__s = end__s - start__s;
+  event->event_id = (int)event_id;
+}
+
+/** \brief Write the recorded events to the trace file
+ *
+ * Events are written in Chrome-trace JSON format, which can be viewed with
+ * chrome://tracing or the Perfetto UI.
+ *
+ * \param trace SolverTrace object
+ * \return Flag indicating whether the file was written (0 = false; 1 = true)
+ */
+int solver_trace_write(SolverTrace trace);
+
+/** \brief Write any recorded events and free the trace buffer
+ *
+ * \param trace Pointer to the SolverTrace object
+ */
+void solver_trace_free(SolverTrace *trace);
+
+#endif
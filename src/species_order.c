@@ -0,0 +1,132 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Solver variable ordering functions
+ *
+ */
+/** \file
+ * \brief Solver variable ordering functions
+ */
+#include "species_order.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INCLUDED_(x) (include_spec == NULL || include_spec[x] != 0)
+
+int species_order_rcm(Jacobian jac, const int *include_spec,
+                      unsigned int *order) {
+  unsigned int num_spec = jac.num_spec;
+
+  // Working arrays
+  unsigned int *adj_ptrs =
+      (unsigned int *)calloc(num_spec + 2, sizeof(unsigned int));
+  unsigned int *adj_ids =
+      (unsigned int *)malloc((2 * jac.num_elem + 1) * sizeof(unsigned int));
+  unsigned int *degree =
+      (unsigned int *)calloc(num_spec + 1, sizeof(unsigned int));
+  int *visited = (int *)calloc(num_spec + 1, sizeof(int));
+
+  if (!adj_ptrs || !adj_ids || !degree || !visited) {
+    free(adj_ptrs);
+    free(adj_ids);
+    free(degree);
+    free(visited);
+    return -1;
+  }
+
+  // Count the neighbors of each species in the symmetrized pattern (row i of
+  // column j couples species i and j)
+  for (unsigned int i_col = 0; i_col < num_spec; ++i_col) {
+    if (!INCLUDED_(i_col)) continue;
+    for (unsigned int i_elem = jac.col_ptrs[i_col];
+         i_elem < jac.col_ptrs[i_col + 1]; ++i_elem) {
+      unsigned int i_row = jac.row_ids[i_elem];
+      if (i_row == i_col || !INCLUDED_(i_row)) continue;
+      ++adj_ptrs[i_col + 2];
+      ++adj_ptrs[i_row + 2];
+    }
+  }
+  for (unsigned int i_spec = 0; i_spec < num_spec; ++i_spec)
+    adj_ptrs[i_spec + 2] += adj_ptrs[i_spec + 1];
+
+  // Fill in the neighbors (duplicates from elements present in both
+  // triangles only change the visiting order of equal-degree species)
+  for (unsigned int i_col = 0; i_col < num_spec; ++i_col) {
+    if (!INCLUDED_(i_col)) continue;
+    for (unsigned int i_elem = jac.col_ptrs[i_col];
+         i_elem < jac.col_ptrs[i_col + 1]; ++i_elem) {
+      unsigned int i_row = jac.row_ids[i_elem];
+      if (i_row == i_col || !INCLUDED_(i_row)) continue;
+      adj_ids[adj_ptrs[i_col + 1]++] = i_row;
+      adj_ids[adj_ptrs[i_row + 1]++] = i_col;
+    }
+  }
+  for (unsigned int i_spec = 0; i_spec < num_spec; ++i_spec)
+    degree[i_spec] = adj_ptrs[i_spec + 1] - adj_ptrs[i_spec];
+
+  // Breadth-first search from a minimum-degree species of each connected
+  // component, adding the neighbors of each species by increasing degree
+  unsigned int num_ordered = 0;
+  for (;;) {
+    unsigned int start = num_spec;
+    for (unsigned int i_spec = 0; i_spec < num_spec; ++i_spec) {
+      if (!INCLUDED_(i_spec) || visited[i_spec]) continue;
+      if (start == num_spec || degree[i_spec] < degree[start]) start = i_spec;
+    }
+    if (start == num_spec) break;
+
+    unsigned int head = num_ordered;
+    order[num_ordered++] = start;
+    visited[start] = 1;
+    while (head < num_ordered) {
+      unsigned int spec = order[head++];
+      unsigned int first_new = num_ordered;
+      for (unsigned int i_adj = adj_ptrs[spec]; i_adj < adj_ptrs[spec + 1];
+           ++i_adj) {
+        unsigned int adj = adj_ids[i_adj];
+        if (visited[adj]) continue;
+        visited[adj] = 1;
+
+        // Insert by degree, after species of equal degree
+        unsigned int pos = num_ordered++;
+        while (pos > first_new && degree[order[pos - 1]] > degree[adj]) {
+          order[pos] = order[pos - 1];
+          --pos;
+        }
+        order[pos] = adj;
+      }
+    }
+  }
+
+  // Reverse the order
+  for (unsigned int i = 0; i < num_ordered / 2; ++i) {
+    unsigned int temp = order[i];
+    order[i] = order[num_ordered - 1 - i];
+    order[num_ordered - 1 - i] = temp;
+  }
+
+  free(adj_ptrs);
+  free(adj_ids);
+  free(degree);
+  free(visited);
+
+  return (int)num_ordered;
+}
+
+unsigned int species_order_bandwidth(Jacobian jac, const int *new_ids) {
+  unsigned int bandwidth = 0;
+  for (unsigned int i_col = 0; i_col < jac.num_spec; ++i_col) {
+    if (new_ids[i_col] < 0) continue;
+    for (unsigned int i_elem = jac.col_ptrs[i_col];
+         i_elem < jac.col_ptrs[i_col + 1]; ++i_elem) {
+      int new_row = new_ids[jac.row_ids[i_elem]];
+      if (new_row < 0) continue;
+      unsigned int dist = new_row > new_ids[i_col]
+                              ? (unsigned int)(new_row - new_ids[i_col])
+                              : (unsigned int)(new_ids[i_col] - new_row);
+      if (dist > bandwidth) bandwidth = dist;
+    }
+  }
+  return bandwidth;
+}
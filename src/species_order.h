@@ -0,0 +1,52 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the solver variable ordering functions
+ *
+ */
+/** \file
+ * \brief Header for the solver variable ordering functions
+ */
+#ifndef SPECIES_ORDER_H_
+#define SPECIES_ORDER_H_
+
+#include "Jacobian.h"
+
+/* Order of the variables on the solver state vector (the values must match
+ * the CAMP_VAR_ORDER_* parameters in the camp_camp_solver_data module) */
+typedef enum {
+  SPECIES_ORDER_STATE,  // Same order as the state array
+  SPECIES_ORDER_RCM     // Reverse Cuthill-McKee order of the Jacobian graph
+} SpeciesOrderType;
+
+/** \brief Order species with the reverse Cuthill-McKee algorithm
+ *
+ * The graph is the symmetrized sparsity pattern of the Jacobian restricted to
+ * the included species. Species that are coupled end up close to each other,
+ * which reduces the bandwidth of the Jacobian. Each connected component is
+ * started from an included species of minimum degree.
+ *
+ * The Jacobian must have been built with \c jacobian_build_matrix.
+ *
+ * \param jac Jacobian with the sparsity pattern to analyze
+ * \param include_spec Flags indicating which species to order
+ *                     (0 = exclude; otherwise include), or NULL to include
+ *                     all species
+ * \param order Set to the ids of the included species in their new order
+ *              (must have space for all included species)
+ * \return Number of ordered species, or -1 if memory could not be allocated
+ */
+int species_order_rcm(Jacobian jac, const int *include_spec,
+                      unsigned int *order);
+
+/** \brief Get the bandwidth of the Jacobian for a species order
+ *
+ * \param jac Jacobian with the sparsity pattern
+ * \param new_ids New position of each species (-1 for species not included)
+ * \return Largest distance from the diagonal of an element between two
+ *         included species
+ */
+unsigned int species_order_bandwidth(Jacobian jac, const int *new_ids);
+
+#endif
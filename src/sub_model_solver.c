@@ -8,6 +8,7 @@
  * \brief Sub model solver functions
  */
 #include "sub_model_solver.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include "sub_models.h"
@@ -308,6 +309,9 @@ void sub_model_update_env_state(ModelData *model_data) {
 void sub_model_calculate(ModelData *model_data) {
   // Get the number of sub models
   int n_sub_model = model_data->n_sub_model;
+  CostProfile *profile = &(model_data->cost_profile);
+  double start__s =
+      profile->level != COST_PROFILE_OFF ? solver_timer_now() : 0.0;
 
   // Loop through the sub models to trigger their calculation
   // advancing the sub_model_data pointer each time
@@ -341,6 +345,9 @@ void sub_model_calculate(ModelData *model_data) {
                                               sub_model_env_data, model_data);
         break;
     }
+    if (profile->level != COST_PROFILE_OFF)
+      start__s = cost_profile_add_sub_model(profile, COST_PROFILE_DERIV,
+                                            sub_model_type, start__s);
   }
 }
 
@@ -355,6 +362,9 @@ void sub_model_get_jac_contrib(ModelData *model_data, double *J_data,
                                realtype time_step) {
   // Get the number of sub models
   int n_sub_model = model_data->n_sub_model;
+  CostProfile *profile = &(model_data->cost_profile);
+  double start__s =
+      profile->level != COST_PROFILE_OFF ? solver_timer_now() : 0.0;
 
   // Loop through the sub models to trigger their Jacobian calculation
   // advancing the sub_model_data pointer each time
@@ -390,6 +400,9 @@ void sub_model_get_jac_contrib(ModelData *model_data, double *J_data,
             model_data, J_data, (double)time_step);
         break;
     }
+    if (profile->level != COST_PROFILE_OFF)
+      start__s = cost_profile_add_sub_model(profile, COST_PROFILE_JAC,
+                                            sub_model_type, start__s);
   }
 
   // Account for sub-model interdependence
@@ -470,11 +483,16 @@ void sub_model_update_data(int cell_id, int *sub_model_id,
                            void *solver_data) {
   ModelData *model_data =
       (ModelData *)&(((SolverData *)solver_data)->model_data);
+  SolverTrace *trace = &(((SolverData *)solver_data)->trace);
+  double start__s = trace->events != NULL ? solver_timer_now() : 0.0;
+
+  // The environment-dependent data of the grid cell must be recalculated
+  model_data->env_cache[cell_id * model_data->n_env_cache] = NAN;
 
   // Point to the environment-dependent data for the grid cell
   model_data->grid_cell_sub_model_env_data =
       &(model_data
-            ->sub_model_env_data[cell_id * model_data->n_sub_model_env_data]);
+            ->sub_model_env_data[cell_id * model_data->n_cell_env_data]);
 
   // Get the number of sub models
   int n_sub_model = model_data->n_sub_model;
@@ -501,6 +519,9 @@ void sub_model_update_data(int cell_id, int *sub_model_id,
 
     // Currently there are no sub-models with update data functions
   }
+  if (trace->events != NULL)
+    solver_trace_add(trace, SOLVER_TRACE_SUB_MODEL_UPDATE_DATA, start__s,
+                     solver_timer_now());
 }
 
 /** \brief Print the sub model data
@@ -0,0 +1,250 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Mechanism subsystem decomposition functions
+ *
+ */
+/** \file
+ * \brief Mechanism subsystem decomposition functions
+ */
+#include "subsystems.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INCLUDED_(x) (include_spec == NULL || include_spec[x] != 0)
+
+// Find the root of a block in the independent group forest
+static unsigned int find_group_root(unsigned int *parent, unsigned int block) {
+  while (parent[block] != block) {
+    parent[block] = parent[parent[block]];
+    block = parent[block];
+  }
+  return block;
+}
+
+int subsystems_initialize(Subsystems *subsys, Jacobian jac,
+                          const int *include_spec) {
+  unsigned int num_spec = jac.num_spec;
+
+  subsys->num_spec = num_spec;
+  subsys->num_var = 0;
+  subsys->num_blocks = 0;
+  subsys->num_groups = 0;
+  subsys->block_ptrs =
+      (unsigned int *)malloc((num_spec + 1) * sizeof(unsigned int));
+  subsys->spec_ids =
+      (unsigned int *)malloc((num_spec + 1) * sizeof(unsigned int));
+  subsys->spec_block = (int *)malloc((num_spec + 1) * sizeof(int));
+  subsys->block_group =
+      (unsigned int *)malloc((num_spec + 1) * sizeof(unsigned int));
+  subsys->num_block_deps =
+      (unsigned int *)calloc(num_spec + 1, sizeof(unsigned int));
+
+  // Working arrays
+  unsigned int *dep_ptrs =
+      (unsigned int *)calloc(num_spec + 1, sizeof(unsigned int));
+  unsigned int *dep_ids =
+      (unsigned int *)malloc((jac.num_elem + 1) * sizeof(unsigned int));
+  unsigned int *next_dep =
+      (unsigned int *)malloc((num_spec + 1) * sizeof(unsigned int));
+  int *index = (int *)malloc((num_spec + 1) * sizeof(int));
+  int *lowlink = (int *)malloc((num_spec + 1) * sizeof(int));
+  unsigned int *stack =
+      (unsigned int *)malloc((num_spec + 1) * sizeof(unsigned int));
+  unsigned int *call_spec =
+      (unsigned int *)malloc((num_spec + 1) * sizeof(unsigned int));
+  unsigned int *call_dep =
+      (unsigned int *)malloc((num_spec + 1) * sizeof(unsigned int));
+
+  if (!subsys->block_ptrs || !subsys->spec_ids || !subsys->spec_block ||
+      !subsys->block_group || !subsys->num_block_deps || !dep_ptrs ||
+      !dep_ids || !next_dep || !index || !lowlink || !stack || !call_spec ||
+      !call_dep) {
+    free(dep_ptrs);
+    free(dep_ids);
+    free(next_dep);
+    free(index);
+    free(lowlink);
+    free(stack);
+    free(call_spec);
+    free(call_dep);
+    subsystems_free(subsys);
+    return 0;
+  }
+
+  // Build the set of species each species depends on from the column-ordered
+  // Jacobian elements (row i of column j means i depends on j)
+  for (unsigned int i_col = 0; i_col < num_spec; ++i_col) {
+    if (!INCLUDED_(i_col)) continue;
+    for (unsigned int i_elem = jac.col_ptrs[i_col];
+         i_elem < jac.col_ptrs[i_col + 1]; ++i_elem) {
+      unsigned int i_row = jac.row_ids[i_elem];
+      if (i_row == i_col || !INCLUDED_(i_row)) continue;
+      ++dep_ptrs[i_row + 1];
+    }
+  }
+  for (unsigned int i_spec = 0; i_spec < num_spec; ++i_spec) {
+    dep_ptrs[i_spec + 1] += dep_ptrs[i_spec];
+    next_dep[i_spec] = dep_ptrs[i_spec];
+  }
+  for (unsigned int i_col = 0; i_col < num_spec; ++i_col) {
+    if (!INCLUDED_(i_col)) continue;
+    for (unsigned int i_elem = jac.col_ptrs[i_col];
+         i_elem < jac.col_ptrs[i_col + 1]; ++i_elem) {
+      unsigned int i_row = jac.row_ids[i_elem];
+      if (i_row == i_col || !INCLUDED_(i_row)) continue;
+      dep_ids[next_dep[i_row]++] = i_col;
+    }
+  }
+
+  // Find the strongly connected components (Tarjan's algorithm, without
+  // recursion). Following the dependency edges, each block is completed only
+  // after every block it depends on, so blocks are found in block-triangular
+  // order.
+  for (unsigned int i_spec = 0; i_spec < num_spec; ++i_spec) {
+    index[i_spec] = -1;
+    subsys->spec_block[i_spec] = -1;
+  }
+  int next_index = 0;
+  unsigned int stack_size = 0;
+  unsigned int num_ordered = 0;
+  subsys->block_ptrs[0] = 0;
+  for (unsigned int root = 0; root < num_spec; ++root) {
+    if (!INCLUDED_(root) || index[root] != -1) continue;
+    int depth = 0;
+    call_spec[0] = root;
+    call_dep[0] = dep_ptrs[root];
+    index[root] = lowlink[root] = next_index++;
+    stack[stack_size++] = root;
+    while (depth >= 0) {
+      unsigned int v = call_spec[depth];
+      if (call_dep[depth] < dep_ptrs[v + 1]) {
+        unsigned int w = dep_ids[call_dep[depth]++];
+        if (index[w] == -1) {
+          // Visit the dependency
+          index[w] = lowlink[w] = next_index++;
+          stack[stack_size++] = w;
+          ++depth;
+          call_spec[depth] = w;
+          call_dep[depth] = dep_ptrs[w];
+        } else if (subsys->spec_block[w] == -1 && index[w] < lowlink[v]) {
+          // Dependency is on the stack
+          lowlink[v] = index[w];
+        }
+        continue;
+      }
+
+      // All dependencies visited; close the block if v is its root
+      if (lowlink[v] == index[v]) {
+        unsigned int w;
+        do {
+          w = stack[--stack_size];
+          subsys->spec_block[w] = (int)subsys->num_blocks;
+          subsys->spec_ids[num_ordered++] = w;
+        } while (w != v);
+        subsys->block_ptrs[++subsys->num_blocks] = num_ordered;
+      }
+      --depth;
+      if (depth >= 0) {
+        unsigned int u = call_spec[depth];
+        if (lowlink[v] < lowlink[u]) lowlink[u] = lowlink[v];
+      }
+    }
+  }
+  subsys->num_var = num_ordered;
+
+  // Group blocks that are connected in either direction and count the direct
+  // dependencies of each block on other blocks (reusing the working arrays)
+  unsigned int *parent = stack;
+  unsigned int *last_dep_block = call_spec;
+  for (unsigned int i_block = 0; i_block < subsys->num_blocks; ++i_block) {
+    parent[i_block] = i_block;
+    last_dep_block[i_block] = subsys->num_blocks;
+  }
+  for (unsigned int i_block = 0; i_block < subsys->num_blocks; ++i_block) {
+    for (unsigned int i_id = subsys->block_ptrs[i_block];
+         i_id < subsys->block_ptrs[i_block + 1]; ++i_id) {
+      unsigned int i_spec = subsys->spec_ids[i_id];
+      for (unsigned int i_dep = dep_ptrs[i_spec]; i_dep < dep_ptrs[i_spec + 1];
+           ++i_dep) {
+        unsigned int dep_block =
+            (unsigned int)subsys->spec_block[dep_ids[i_dep]];
+        if (dep_block == i_block) continue;
+        if (last_dep_block[dep_block] != i_block) {
+          last_dep_block[dep_block] = i_block;
+          ++subsys->num_block_deps[i_block];
+        }
+        unsigned int root_a = find_group_root(parent, i_block);
+        unsigned int root_b = find_group_root(parent, dep_block);
+        if (root_a != root_b) parent[root_a] = root_b;
+      }
+    }
+  }
+
+  // Number the independent groups in order of their first block
+  unsigned int *group_id = call_dep;
+  for (unsigned int i_block = 0; i_block < subsys->num_blocks; ++i_block)
+    group_id[i_block] = subsys->num_blocks;
+  for (unsigned int i_block = 0; i_block < subsys->num_blocks; ++i_block) {
+    unsigned int root = find_group_root(parent, i_block);
+    if (group_id[root] == subsys->num_blocks)
+      group_id[root] = subsys->num_groups++;
+    subsys->block_group[i_block] = group_id[root];
+  }
+
+  free(dep_ptrs);
+  free(dep_ids);
+  free(next_dep);
+  free(index);
+  free(lowlink);
+  free(stack);
+  free(call_spec);
+  free(call_dep);
+
+  return 1;
+}
+
+unsigned int subsystems_block_size(Subsystems subsys, unsigned int block_id) {
+  return subsys.block_ptrs[block_id + 1] - subsys.block_ptrs[block_id];
+}
+
+unsigned int subsystems_largest_block_size(Subsystems subsys) {
+  unsigned int largest = 0;
+  for (unsigned int i_block = 0; i_block < subsys.num_blocks; ++i_block) {
+    unsigned int size = subsystems_block_size(subsys, i_block);
+    if (size > largest) largest = size;
+  }
+  return largest;
+}
+
+void subsystems_print(Subsystems subsys) {
+  printf("\n\nMechanism subsystems\n");
+  printf("\n  species: %u blocks: %u independent groups: %u largest block: %u",
+         subsys.num_var, subsys.num_blocks, subsys.num_groups,
+         subsystems_largest_block_size(subsys));
+  for (unsigned int i_block = 0; i_block < subsys.num_blocks; ++i_block) {
+    printf("\n  block %u (group %u, depends on %u blocks):", i_block,
+           subsys.block_group[i_block], subsys.num_block_deps[i_block]);
+    for (unsigned int i_id = subsys.block_ptrs[i_block];
+         i_id < subsys.block_ptrs[i_block + 1]; ++i_id)
+      printf(" %u", subsys.spec_ids[i_id]);
+  }
+  printf("\n");
+}
+
+void subsystems_free(Subsystems *subsys) {
+  free(subsys->block_ptrs);
+  free(subsys->spec_ids);
+  free(subsys->spec_block);
+  free(subsys->block_group);
+  free(subsys->num_block_deps);
+  subsys->block_ptrs = NULL;
+  subsys->spec_ids = NULL;
+  subsys->spec_block = NULL;
+  subsys->block_group = NULL;
+  subsys->num_block_deps = NULL;
+  subsys->num_blocks = 0;
+  subsys->num_groups = 0;
+  subsys->num_var = 0;
+}
@@ -0,0 +1,83 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Header for the mechanism subsystem decomposition and related functions
+ *
+ */
+/** \file
+ * \brief Header for the mechanism subsystem decomposition and related
+ *        functions
+ */
+#ifndef SUBSYSTEMS_H_
+#define SUBSYSTEMS_H_
+
+#include <stdlib.h>
+#include "Jacobian.h"
+
+/* Decomposition of the mechanism into coupled blocks of species
+ *
+ * Blocks are the strongly connected components of the graph formed by the
+ * Jacobian sparsity pattern. They are stored in block-triangular order, so
+ * every block only depends on itself and on blocks that come before it.
+ * Blocks that are not connected to each other, either directly or through
+ * other blocks, are placed in separate independent groups.
+ */
+typedef struct {
+  unsigned int num_spec;    // Number of species in the Jacobian
+  unsigned int num_var;     // Number of species included in the blocks
+  unsigned int num_blocks;  // Number of strongly connected blocks
+  unsigned int num_groups;  // Number of independent groups of blocks
+  unsigned int *block_ptrs;  // Index of start/end of each block in spec_ids
+  unsigned int *spec_ids;    // Species ids ordered by block
+  int *spec_block;           // Block id for each species (-1 for species not
+                             // included in the decomposition)
+  unsigned int *block_group;     // Independent group id for each block
+  unsigned int *num_block_deps;  // Number of other blocks each block depends
+                                 // on directly
+} Subsystems;
+
+/** \brief Decompose a Jacobian sparsity pattern into coupled blocks
+ *
+ * The Jacobian must have been built with \c jacobian_build_matrix. Element
+ * (i, j) is taken to mean that species i depends on species j.
+ *
+ * \param subsys Pointer to the Subsystems object to set up
+ * \param jac Jacobian with the sparsity pattern to analyze
+ * \param include_spec Flags indicating which species to include in the
+ *                     decomposition (0 = exclude; otherwise include), or NULL
+ *                     to include all species
+ * \return Flag indicating whether the decomposition was successful
+ *         (0 = false; 1 = true)
+ */
+int subsystems_initialize(Subsystems *subsys, Jacobian jac,
+                          const int *include_spec);
+
+/** \brief Get the number of species in a block
+ *
+ * \param subsys Subsystems object
+ * \param block_id Block index (0...number of blocks-1)
+ * \return Number of species in the block
+ */
+unsigned int subsystems_block_size(Subsystems subsys, unsigned int block_id);
+
+/** \brief Get the number of species in the largest block
+ *
+ * \param subsys Subsystems object
+ * \return Number of species in the largest block
+ */
+unsigned int subsystems_largest_block_size(Subsystems subsys);
+
+/** \brief Print a summary of the decomposition
+ *
+ * \param subsys Subsystems object
+ */
+void subsystems_print(Subsystems subsys);
+
+/** \brief Free memory associated with a Subsystems object
+ *
+ * \param subsys Pointer to the Subsystems object
+ */
+void subsystems_free(Subsystems *subsys);
+
+#endif
@@ -0,0 +1,145 @@
+#!/bin/bash
+
+# Generate a synthetic CAMP configuration for scalability studies
+#
+# Usage: gen_scaling_config.sh n_copies n_bins output_dir [source_dir]
+#   n_copies: number of copies of the CB05 gas-phase mechanism to include
+#   n_bins: number of bins in each binned aerosol mode (0 = gas phase only)
+#   output_dir: directory for the generated files
+#   source_dir: directory with the CAMP v1 paper binned input files
+#               (default: the copy in the build directory data_run folder)
+#
+# Copy k > 1 of the mechanism has every gas-phase species renamed to
+# <name>_<k>, except for the species listed in SHARED_SPECIES, so each copy
+# adds a full set of independent reactions and state variables. The shared
+# species are only defined by copy 1, as a species can only be defined once
+# with each property. The SOA
+# scheme and aerosol phases are only included once, and only when n_bins > 0.
+#
+# The configuration file list is written to <output_dir>/config.json, with
+# absolute paths to the generated files.
+
+# exit on error
+set -e
+
+if [ $# -lt 3 ] || [ $# -gt 4 ]; then
+  echo "Usage: gen_scaling_config.sh n_copies n_bins output_dir [source_dir]"
+  exit 1
+fi
+N_COPIES=$1
+N_BINS=$2
+if ! [[ $N_COPIES =~ ^[0-9]+$ ]] || [ $N_COPIES -lt 1 ]; then
+  echo "Invalid number of mechanism copies: $N_COPIES"
+  exit 1
+fi
+if ! [[ $N_BINS =~ ^[0-9]+$ ]]; then
+  echo "Invalid number of aerosol bins: $N_BINS"
+  exit 1
+fi
+mkdir -p $3
+OUT_DIR=$(cd $3 && pwd)
+SCRIPT_DIR=$(cd ${0%/*} && pwd)
+SRC_DIR=${4:-$SCRIPT_DIR/../../data_run/CAMP_v1_paper/binned/monarch_box_binned}
+SRC_DIR=$(cd $SRC_DIR && pwd)
+
+# Species shared by all copies of the mechanism (third body, bath gases and
+# gas-phase water)
+SHARED_SPECIES="M O2 N2 H2O"
+
+# Remove the shared species from a species or tolerance file read from stdin
+drop_shared() {
+  awk -v shared="$SHARED_SPECIES" '
+    BEGIN { n = split(shared, names, " ")
+            for (i = 1; i <= n; i++) skip["\"" names[i] "\""] = 1 }
+    in_obj {
+      obj = obj "\n" $0
+      if ($0 ~ /"name" *:/) {
+        name = $0; sub(/^[^:]*: */, "", name); sub(/ *,? *$/, "", name)
+        if (name in skip) drop = 1
+      }
+      if ($0 ~ /^ *},? *$/) {
+        in_obj = 0
+        if (drop) next
+        sub(/,? *$/, "", obj)
+        if (held != "") print held ","
+        held = obj
+      }
+      next
+    }
+    in_data && /^ *{ *$/ { in_obj = 1; obj = $0; drop = 0; next }
+    in_data && /^ *]/ { if (held != "") print held; held = ""; in_data = 0 }
+    /"camp-data"/ { in_data = 1 }
+    { print }
+  '
+}
+
+MECH=cb05_mechanism.noR142R143.json
+SPEC=cb05_species.json
+TOL=cb05_abs_tol.json
+
+# Copy 1 is the original mechanism
+FILES="$OUT_DIR/$TOL $OUT_DIR/$MECH $OUT_DIR/$SPEC"
+cp $SRC_DIR/$TOL $SRC_DIR/$MECH $SRC_DIR/$SPEC $OUT_DIR/
+
+# Copies 2...n_copies with renamed species, reactions and mechanism
+SPEC_NAMES=$(sed -n 's/^ *"name" *: *"\([^"]*\)".*/\1/p' $SRC_DIR/$SPEC)
+for (( k=2; k<=$N_COPIES; k++ ))
+do
+  RENAME=$OUT_DIR/rename_$k.sed
+  : > $RENAME
+  for name in $SPEC_NAMES
+  do
+    case " $SHARED_SPECIES " in
+      *" $name "*) continue ;;
+    esac
+    echo "s/\"$name\" *:/\"${name}_$k\" :/g" >> $RENAME
+    echo "s/\"name\" *: *\"$name\"/\"name\" : \"${name}_$k\"/" >> $RENAME
+  done
+  echo "s/\"rxn id\" *: *\"\\([^\"]*\\)\"/\"rxn id\" : \"\\1_$k\"/" >> $RENAME
+  echo "s/\"name\" *: *\"MONARCH mod37\"/\"name\" : \"MONARCH mod37 copy $k\"/" \
+       >> $RENAME
+  sed -f $RENAME $SRC_DIR/$MECH > $OUT_DIR/${MECH%.json}_$k.json
+  for file in $SPEC $TOL
+  do
+    sed -f $RENAME $SRC_DIR/$file | drop_shared > $OUT_DIR/${file%.json}_$k.json
+  done
+  for file in $MECH $SPEC $TOL
+  do
+    FILES="$FILES $OUT_DIR/${file%.json}_$k.json"
+  done
+  rm $RENAME
+done
+
+# Aerosol representation with n_bins bins per binned mode
+if [ $N_BINS -gt 0 ]; then
+  sed "s/\"bins\" *: *[0-9]*/\"bins\" : $N_BINS/" \
+      $SRC_DIR/monarch_mod37_aerosol_representation.json \
+      > $OUT_DIR/monarch_mod37_aerosol_representation.json
+  mkdir -p $OUT_DIR/tsigaridis_2_product_SOA_scheme
+  cp $SRC_DIR/aerosol_phases.json $SRC_DIR/custom_species.json \
+     $SRC_DIR/partitioning_species_params.json $OUT_DIR/
+  cp $SRC_DIR/tsigaridis_2_product_SOA_scheme/mechanism.json \
+     $SRC_DIR/tsigaridis_2_product_SOA_scheme/species.json \
+     $OUT_DIR/tsigaridis_2_product_SOA_scheme/
+  FILES="$FILES $OUT_DIR/monarch_mod37_aerosol_representation.json"
+  FILES="$FILES $OUT_DIR/aerosol_phases.json"
+  FILES="$FILES $OUT_DIR/custom_species.json"
+  FILES="$FILES $OUT_DIR/partitioning_species_params.json"
+  FILES="$FILES $OUT_DIR/tsigaridis_2_product_SOA_scheme/mechanism.json"
+  FILES="$FILES $OUT_DIR/tsigaridis_2_product_SOA_scheme/species.json"
+fi
+
+# Configuration file list
+{
+  echo "{"
+  echo "  \"camp-files\" : ["
+  sep=""
+  for file in $FILES
+  do
+    printf "$sep    \"%s\"" $file
+    sep=",\n"
+  done
+  echo ""
+  echo "  ]"
+  echo "}"
+} > $OUT_DIR/config.json
@@ -0,0 +1,40 @@
+#!/bin/bash
+
+# Run the CAMP solver microbenchmarks for the standard mechanisms
+#
+# Usage: run_camp_bench.sh [cell_counts [n_repeat]]
+#   cell_counts: comma-separated numbers of grid cells (default 1,10,100)
+#   n_repeat: number of calls to time for each kernel (default 10)
+#
+# Results are written to out/bench_<mechanism>.json
+
+# exit on error
+set -e
+# turn on command echoing
+set -v
+# make sure that the current directory is the one where this script is
+cd ${0%/*}
+# make the output directory if it doesn't exist
+mkdir -p out
+
+CELLS=${1:-1,10,100}
+REPEAT=${2:-10}
+BUILD_DIR=$(cd ../.. && pwd)
+OUT_DIR=$(pwd)/out
+BENCH=$BUILD_DIR/camp_bench
+
+# CB05 with chlorine and aerosol updates
+(cd ../chemistry/cb05cl_ae5 && \
+  $BENCH config_cb05cl_ae5.json $OUT_DIR/bench_cb05cl_ae5.json $CELLS $REPEAT)
+
+# MONARCH mod37 (file paths are relative to a MONARCH run directory)
+mkdir -p out/monarch_mod37/camp
+ln -sfn $BUILD_DIR/mechanisms_run/monarch_mod37 out/monarch_mod37/camp/mod37
+(cd out/monarch_mod37 && \
+  $BENCH camp/mod37/config.json $OUT_DIR/bench_monarch_mod37.json $CELLS $REPEAT)
+
+# CAMP v1 paper configurations
+(cd $BUILD_DIR/data_run/CAMP_v1_paper/binned && \
+  $BENCH config_monarch_binned.json $OUT_DIR/bench_camp_v1_binned.json $CELLS $REPEAT)
+(cd $BUILD_DIR/data_run/CAMP_v1_paper/modal && \
+  $BENCH config_monarch_modal.json $OUT_DIR/bench_camp_v1_modal.json $CELLS $REPEAT)
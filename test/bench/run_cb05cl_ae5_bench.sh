@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# Compare the cost and accuracy of the EBI, KPP and CAMP-chem solvers for
+# the CB05 mechanism over many grid cells and time steps
+#
+# Usage: run_cb05cl_ae5_bench.sh [n_cells [n_steps [time_step [rel_tols]]]]
+#   n_cells: number of grid cells (default 24)
+#   n_steps: number of time steps (default 144)
+#   time_step: time step in s (default 600)
+#   rel_tols: comma-separated relative tolerances for the KPP and CAMP-chem
+#             solvers (default 1.0e-2,1.0e-3,1.0e-4)
+#
+# Results are written to out/bench_cb05cl_ae5_solvers.json
+
+# exit on error
+set -e
+# turn on command echoing
+set -v
+# make sure that the current directory is the one where this script is
+cd ${0%/*}
+# make the output directory if it doesn't exist
+mkdir -p out
+
+BUILD_DIR=$(cd ../.. && pwd)
+OUT_DIR=$(pwd)/out
+
+(cd ../chemistry/cb05cl_ae5 && \
+  $BUILD_DIR/bench_cb05cl_ae5 $OUT_DIR/bench_cb05cl_ae5_solvers.json "$@")
@@ -0,0 +1,68 @@
+#!/bin/bash
+
+# Measure how the CAMP load, initialization and solver costs scale with the
+# size of the mechanism, the number of aerosol bins and the number of cells
+#
+# Usage: run_scaling_bench.sh [copies [bins [cell_counts [n_repeat]]]]
+#   copies: comma-separated numbers of copies of the CB05 gas-phase
+#           mechanism (default 1,2,4,8)
+#   bins: comma-separated numbers of bins per binned aerosol mode; 0 runs
+#         the gas-phase mechanism only (default 0,8,32)
+#   cell_counts: comma-separated numbers of grid cells (default 1,10,100)
+#   n_repeat: number of calls to time for each kernel (default 10)
+#
+# Configurations are generated with gen_scaling_config.sh. Each combination
+# is run in a separate process so that the reported peak memory belongs to
+# a single problem size. Results are written to
+# out/scaling/bench_n<copies>_b<bins>_c<cells>.json, with a summary of all
+# runs in out/scaling/summary.txt.
+
+# exit on error
+set -e
+# turn on command echoing
+set -v
+# make sure that the current directory is the one where this script is
+cd ${0%/*}
+# make the output directory if it doesn't exist
+mkdir -p out/scaling
+
+COPIES=${1:-1,2,4,8}
+BINS=${2:-0,8,32}
+CELLS=${3:-1,10,100}
+REPEAT=${4:-10}
+BUILD_DIR=$(cd ../.. && pwd)
+OUT_DIR=$(pwd)/out/scaling
+BENCH=$BUILD_DIR/camp_bench
+SUMMARY=$OUT_DIR/summary.txt
+
+# get a numeric field from a camp_bench output file
+field() {
+  sed -n "s/^ *\"$1\" : \([^,]*\),*$/\1/p" $2 | head -n 1
+}
+
+printf "%8s %6s %8s %8s %10s %12s %12s %12s %12s %12s %12s %14s\n" \
+       copies bins cells n_rxn state_size load_s init_s solver_init_s \
+       f_s Jac_s solve_s peak_mem_kB > $SUMMARY
+for n in ${COPIES//,/ }
+do
+  for b in ${BINS//,/ }
+  do
+    CONFIG_DIR=$OUT_DIR/config_n${n}_b${b}
+    ./gen_scaling_config.sh $n $b $CONFIG_DIR
+    for c in ${CELLS//,/ }
+    do
+      RESULT=$OUT_DIR/bench_n${n}_b${b}_c${c}.json
+      $BENCH $CONFIG_DIR/config.json $RESULT $c $REPEAT
+      printf "%8s %6s %8s %8s %10s %12s %12s %12s %12s %12s %12s %14s\n" \
+             $n $b $c $(field n_rxn $RESULT) \
+             $(field state_size_per_cell $RESULT) $(field load__s $RESULT) \
+             $(field initialize__s $RESULT) \
+             $(field solver_initialize__s $RESULT) \
+             $(sed -n 's/^ *"f" : { "mean__s" : *\([^,]*\),.*/\1/p' $RESULT) \
+             $(sed -n 's/^ *"Jac" : { "mean__s" : *\([^,]*\),.*/\1/p' $RESULT) \
+             $(field time__s $RESULT) $(field peak_memory__kB $RESULT) \
+             >> $SUMMARY
+    done
+  done
+done
+cat $SUMMARY
@@ -0,0 +1,59 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ *
+ * Heap allocation counter for allocation tests
+ *
+ */
+/** \file
+ * \brief Heap allocation counter for allocation tests
+ *
+ * Replaces \c malloc, \c calloc, \c realloc and \c free with versions that
+ * forward to the glibc implementations and count the allocations made by the
+ * calling thread between \c alloc_counter_start() and
+ * \c alloc_counter_stop(). Linking this file into an executable interposes
+ * these functions for the CAMP library and the Fortran runtime as well.
+ */
+#include <stddef.h>
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t num, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+// Only allocations on the thread that started the counter are counted
+static _Thread_local int counting = 0;
+static long long num_allocs = 0;
+
+void *malloc(size_t size) {
+  if (counting) ++num_allocs;
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t num, size_t size) {
+  if (counting) ++num_allocs;
+  return __libc_calloc(num, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  if (counting) ++num_allocs;
+  return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) { __libc_free(ptr); }
+
+/** \brief Start counting heap allocations on the calling thread
+ */
+void alloc_counter_start() {
+  num_allocs = 0;
+  counting = 1;
+}
+
+/** \brief Stop counting heap allocations
+ *
+ * \return Number of allocations since the counter was started
+ */
+long long alloc_counter_stop() {
+  counting = 0;
+  return num_allocs;
+}
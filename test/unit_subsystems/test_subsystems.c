@@ -0,0 +1,105 @@
+/* Copyright (C) 2021 Barcelona Supercomputing Center and University of
+ * Illinois at Urbana-Champaign
+ * SPDX-License-Identifier: MIT
+ */
+/** \file
+ * \brief Tests for the mechanism subsystem decomposition
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "../test_common.h"
+#include "../../src/Jacobian.h"
+#include "../../src/subsystems.h"
+
+// Number of variables
+#define NUM_VAR 6
+
+int main(int argc, char * argv[]) {
+
+  int errors = 0;
+
+  Jacobian jac;
+  errors+=ASSERT_MSG(jacobian_initialize_empty(&jac, NUM_VAR)==1, "612350983");
+
+  // diagonal elements
+  for (int i=0; i<NUM_VAR; ++i) jacobian_register_element(&jac, i, i);
+
+  // species 0 and 1 are coupled
+  jacobian_register_element(&jac, 0, 1);
+  jacobian_register_element(&jac, 1, 0);
+
+  // species 2 depends on species 0 (one-way coupling)
+  jacobian_register_element(&jac, 2, 0);
+
+  // species 3 and 4 are coupled, but independent of species 0-2
+  jacobian_register_element(&jac, 3, 4);
+  jacobian_register_element(&jac, 4, 3);
+
+  // species 5 depends on species 3, but is excluded from the decomposition
+  jacobian_register_element(&jac, 5, 3);
+
+  errors+=ASSERT_MSG(jacobian_build_matrix(&jac)==1, "249117830");
+
+  int include_spec[NUM_VAR] = { 1, 1, 1, 1, 1, 0 };
+
+  Subsystems subsys;
+  errors+=ASSERT_MSG(subsystems_initialize(&subsys, jac, include_spec)==1,
+                     "873316052");
+
+  errors+=ASSERT_MSG(subsys.num_var==5, "190824476");
+  errors+=ASSERT_MSG(subsys.num_blocks==3, "347259818");
+  errors+=ASSERT_MSG(subsys.num_groups==2, "922718935");
+  errors+=ASSERT_MSG(subsystems_largest_block_size(subsys)==2, "554096218");
+
+  // coupled species share a block
+  errors+=ASSERT_MSG(subsys.spec_block[0]==subsys.spec_block[1], "706157723");
+  errors+=ASSERT_MSG(subsys.spec_block[3]==subsys.spec_block[4], "126590336");
+  errors+=ASSERT_MSG(subsys.spec_block[0]!=subsys.spec_block[2], "457381194");
+  errors+=ASSERT_MSG(subsys.spec_block[5]==-1, "840911647");
+
+  // blocks are in block-triangular order
+  errors+=ASSERT_MSG(subsys.spec_block[0]<subsys.spec_block[2], "395018263");
+  errors+=ASSERT_MSG(subsys.num_block_deps[subsys.spec_block[2]]==1,
+                     "180462917");
+  errors+=ASSERT_MSG(subsys.num_block_deps[subsys.spec_block[0]]==0,
+                     "603381225");
+  errors+=ASSERT_MSG(subsys.num_block_deps[subsys.spec_block[3]]==0,
+                     "271934850");
+
+  // independent groups
+  errors+=ASSERT_MSG(subsys.block_group[subsys.spec_block[0]]==
+                     subsys.block_group[subsys.spec_block[2]], "519774032");
+  errors+=ASSERT_MSG(subsys.block_group[subsys.spec_block[0]]!=
+                     subsys.block_group[subsys.spec_block[3]], "868216540");
+
+  // block sizes and species ordering
+  for (unsigned int i_block=0; i_block<subsys.num_blocks; ++i_block) {
+    for (unsigned int i_id=subsys.block_ptrs[i_block];
+         i_id<subsys.block_ptrs[i_block+1]; ++i_id) {
+      errors+=ASSERT_MSG(subsys.spec_block[subsys.spec_ids[i_id]]==(int)i_block,
+                         "339702561");
+    }
+  }
+  errors+=ASSERT_MSG(subsystems_block_size(subsys, subsys.spec_block[2])==1,
+                     "742219035");
+
+  subsystems_free(&subsys);
+
+  // with all species included, species 5 forms its own block in the second
+  // group
+  errors+=ASSERT_MSG(subsystems_initialize(&subsys, jac, NULL)==1, "127720594");
+  errors+=ASSERT_MSG(subsys.num_var==6, "585303661");
+  errors+=ASSERT_MSG(subsys.num_blocks==4, "920813342");
+  errors+=ASSERT_MSG(subsys.num_groups==2, "321875029");
+  errors+=ASSERT_MSG(subsys.spec_block[3]<subsys.spec_block[5], "650140384");
+
+  subsystems_free(&subsys);
+  jacobian_free(&jac);
+
+  if (errors==0) {
+    printf("\nPASS\n");
+  } else {
+    printf("\nFAIL\n");
+  }
+  return errors;
+}